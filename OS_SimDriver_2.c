@@ -14,9 +14,27 @@ int main( int argc, char **argv )
          Boolean configUploadFlag = False;
          Boolean mdDisplayFlag = False;
          Boolean runSimFlag = False;
+         Boolean virtualTimeFlag = False;
+         Boolean timingWheelFlag = False;
+         Boolean badArgFlag = False;
          Boolean infoFlag = False;
          int argIndex = 1;
          int lastFourLetters = 4;
+         int burstAlpha = 0;
+         int burstFlagLength = 3;
+         int defaultBurstAlpha = 50;
+         int maxBurstAlpha = 100;
+         int pageFlagLength = 3;
+         int pageReplaceCode = 0;
+         int pageSize = 0;
+         int pageFrames = 0;
+         int placeCode = PLACE_NONE;
+         int placeFlagLength = 3;
+         int compactPercent = 0;
+         int compactFlagLength = 3;
+         int maxCompactPercent = 100;
+         int argStrIndex;
+         char pageArgStr[ MAX_STR_LEN ];
          int fileStrLen, fileStrSubLoc;
          char fileName[ STD_STR_LEN ];
          char errorMessage[ MAX_STR_LEN ];
@@ -83,6 +101,128 @@ int main( int argc, char **argv )
                   //set run simulator flag
                   runSimFlag = True;
                }
+
+            //otherwise, check for -vt (run simulator on virtual time)
+               //function: compareString
+            else if( compareString( argv[ argIndex ], "-vt" ) == STR_EQ )
+               {
+                  //set virtual time flag
+                  virtualTimeFlag = True;
+               }
+
+            //otherwise, check for -tw (keep I/O events on timing wheel)
+               //function: compareString
+            else if( compareString( argv[ argIndex ], "-tw" ) == STR_EQ )
+               {
+                  //set timing wheel flag
+                  timingWheelFlag = True;
+               }
+
+            //otherwise, check for -bp (predict CPU bursts), with optional
+            // percent weight of newest burst right after it
+               //function: findSubString, isDigit, getNumberArg
+            else if( findSubString( argv[ argIndex ], "-bp" ) == 0 )
+               {
+                  //set burst weight, default when not given
+                  burstAlpha = defaultBurstAlpha;
+                  if( fileStrLen > burstFlagLength )
+                     {
+                        //weight must be digits only
+                        if( isDigit( argv[ argIndex ][ burstFlagLength ] )
+                                                                  == False
+                             || getNumberArg( &burstAlpha, argv[ argIndex ],
+                                        burstFlagLength ) != fileStrLen )
+                           {
+                              burstAlpha = 0;
+                           }
+                     }
+
+                  //check for weight out of range
+                  if( burstAlpha < 1 || burstAlpha > maxBurstAlpha )
+                     {
+                        badArgFlag = True;
+                     }
+               }
+            //otherwise, check for -pg (demand paging), replacement policy
+            // right after it, then optional page size in KB and frame count
+               //function: findSubString, hasNextArg, getStringArg,
+               //          findPageReplaceCode, getNumberArg
+            else if( findSubString( argv[ argIndex ], "-pg" ) == 0 )
+               {
+                  //set defaults, policy must be given
+                  argStrIndex = pageFlagLength;
+                  pageReplaceCode = -1;
+                  pageSize = DEFAULT_PAGE_SIZE;
+                  pageFrames = 0;
+
+                  //get policy name
+                  if( fileStrLen < MAX_STR_LEN
+                       && hasNextArg( argv[ argIndex ], argStrIndex ) == True )
+                     {
+                        argStrIndex = getStringArg( pageArgStr,
+                                             argv[ argIndex ], argStrIndex );
+                        pageReplaceCode = findPageReplaceCode( pageArgStr );
+                     }
+
+                  //get page size, if given
+                  if( hasNextArg( argv[ argIndex ], argStrIndex ) == True )
+                     {
+                        argStrIndex = getNumberArg( &pageSize,
+                                             argv[ argIndex ], argStrIndex );
+                     }
+
+                  //get frame count, if given, otherwise left to memory size
+                  if( hasNextArg( argv[ argIndex ], argStrIndex ) == True )
+                     {
+                        argStrIndex = getNumberArg( &pageFrames,
+                                             argv[ argIndex ], argStrIndex );
+                        if( pageFrames < 1 )
+                           {
+                              badArgFlag = True;
+                           }
+                     }
+
+                  //check for unknown policy, bad size, or text left over
+                  if( pageReplaceCode < 0 || pageSize < 1
+                       || hasNextArg( argv[ argIndex ], argStrIndex ) == True )
+                     {
+                        badArgFlag = True;
+                     }
+               }
+            //otherwise, check for -pl (place mem allocate blocks), 
+            // allocator name right after it
+               //function: findSubString, findPlacementCode
+            else if( findSubString( argv[ argIndex ], "-pl" ) == 0 )
+               {
+                  //allocator must be known
+                  placeCode = findPlacementCode( 
+                                    &argv[ argIndex ][ placeFlagLength ] );
+                  if( placeCode == PLACE_NONE )
+                     {
+                        badArgFlag = True;
+                     }
+               }
+            //otherwise, check for -cp (compact placed memory), percent
+            // of free memory outside largest free block right after it
+               //function: findSubString, isDigit, getNumberArg
+            else if( findSubString( argv[ argIndex ], "-cp" ) == 0 )
+               {
+                  //percent must be digits only
+                  compactPercent = 0;
+                  if( isDigit( argv[ argIndex ][ compactFlagLength ] ) 
+                                                                  == False
+                       || getNumberArg( &compactPercent, argv[ argIndex ],
+                                        compactFlagLength ) != fileStrLen )
+                     {
+                        compactPercent = 0;
+                     }
+
+                  //check for percent out of range
+                  if( compactPercent < 1 || compactPercent > maxCompactPercent )
+                     {
+                        badArgFlag = True;
+                     }
+               }
             //otherwise, check for file name, ending in .cnf
             //must be last flag
             else if( fileStrSubLoc != SUBSTRING_NOT_FOUND
@@ -98,6 +238,16 @@ int main( int argc, char **argv )
              argIndex++;   
             }
             //end arg loop
+
+      //bad flag value, paging and placing together, or compacting blocks
+      // not placed by a fit, stops run
+      if( badArgFlag == True || ( pageSize > 0 && placeCode != PLACE_NONE )
+           || ( compactPercent > 0 && placeCode != PLACE_FIRST_FIT
+                 && placeCode != PLACE_NEXT_FIT
+                 && placeCode != PLACE_BEST_FIT ) )
+         {
+            programRunFlag = False;
+         }
       
       //check for command line failure
       if( programRunFlag == False && infoFlag == False )
@@ -119,6 +269,16 @@ int main( int argc, char **argv )
                  && getConfigData( fileName, &configDataPtr, errorMessage ) 
                                                      == True )
                { 
+                  //store command line settings with config data
+                  configDataPtr->virtualTime = virtualTimeFlag;
+                  configDataPtr->timingWheel = timingWheelFlag;
+                  configDataPtr->burstAlpha = burstAlpha;
+                  configDataPtr->pageSize = pageSize;
+                  configDataPtr->pageFrames = pageFrames;
+                  configDataPtr->pageReplaceCode = pageReplaceCode;
+                  configDataPtr->placeCode = placeCode;
+                  configDataPtr->compactPercent = compactPercent;
+
                   //check config display flag
                   if( configDisplayFlag == True )
                      {
@@ -204,9 +364,28 @@ void showProgramFormat()
       //print out command line argument instructions
          //function: printf
       printf( "Program Format:\n" );
-      printf( "     sim_0x [-dc] [-dm] [-rs] <config file name>\n" );
+      printf( "     sim_0x [-dc] [-dm] [-rs] [-vt] [-tw] [-bp[alpha]]"
+               " [-pg<policy>[,size[,frames]]] [-pl<allocator>]"
+                                " [-cp<percent>] <config file name>\n" );
       printf( "     -dc [optional] displays configuration data\n"  );
       printf( "     -dm [optional] displays meta data\n" );
       printf( "     -rs [optional] runs simulator\n");
+      printf( "     -vt [optional] runs simulator on virtual time\n");
+      printf( "     -tw [optional] keeps I/O events on a timing wheel\n");
+      printf( "     -bp [optional] ranks SJF-N and SRTF-P by predicted CPU"
+                                                        " bursts, newest\n");
+      printf( "         burst weighted alpha percent, 1 to 100, default 50\n");
+      printf( "     -pg [optional] pages memory on demand, policy fifo, lru,"
+                                                        " clock, or ws,\n");
+      printf( "         page size in KB, default 4, and frame count,"
+                                               " default fills memory\n");
+      printf( "     -pl [optional] places mem allocate blocks by allocator"
+                                           " first, next, best,\n");
+      printf( "         buddy, or slab, op's base only names block, not"
+                                                      " with -pg\n");
+      printf( "     -cp [optional] compacts memory placed by first, next, or"
+                                                        " best when a\n");
+      printf( "         mem free leaves percent of free memory outside"
+                                            " largest free block\n");
       printf( "     config file name is required\n");
    }
@@ -1,6 +1,7 @@
 //header file
 
 #include "configops.h"
+#include "schedops.h"
 
 
 /*
@@ -39,14 +40,25 @@ Notes: none
 */
 void configCodeToString( int code, char *outString )
    {
-      //Define array with eight items, and short (10) lengths
-      char displayStrings[ 8 ][ 10 ] = { "SJF_N", "SRTF-P", "FCFS-P",
-                                         "RR-P", "FCFS-N", "Monitor",
-                                         "File", "Both" };
+      //Define array with log to items, and short (10) lengths
+      char displayStrings[ 3 ][ 10 ] = { "Monitor", "File", "Both" };
 
-      //copy string to return parameter
-         //function: copyString
-      copyString( outString, displayStrings[ code ]);
+      //check for scheduling code, named by its policy
+      if( code < LOGTO_MONITOR_CODE )
+       {
+         //copy policy name to return parameter
+            //function: getSchedPolicy, copyString
+         copyString( outString, 
+                        (char *) getSchedPolicy( code )->displayName );
+       }
+
+      //otherwise, assume log to code
+      else
+       {
+         //copy string to return parameter
+            //function: copyString
+         copyString( outString, displayStrings[ code - LOGTO_MONITOR_CODE ]);
+       }
 
    }
 
@@ -159,6 +171,17 @@ Boolean getConfigData( char *fileName,
          }
       //create temporary pointer to configuration data structure
       tempData = (ConfigDataType *) malloc( sizeof( ConfigDataType ) );
+
+      //set command line controlled items to defaults
+      tempData->virtualTime = False;
+      tempData->timingWheel = False;
+      tempData->burstAlpha = 0;
+      tempData->pageSize = 0;
+      tempData->pageFrames = 0;
+      tempData->pageReplaceCode = 0;
+      tempData->placeCode = 0;
+      tempData->compactPercent = 0;
+
       //loop to end of config data items
       while(lineCtr < NUM_DATA_LINES )
 	{
@@ -338,66 +361,29 @@ Boolean getConfigData( char *fileName,
 
 /*
 Function Name: getCpuSchedCode
-Algorithm: converts string data (e.g., "File", "Monitor")
-           to constant code number to be stored as integer
-Precondition: codeStr is a C-Style string with one
-              of the specified log to operations
-Postcondition: returns code representing log to actions
-Exceptions: defaults to monitor code
-Notes: none
+Algorithm: looks up string data (e.g., "RR-P", "SJF-N")
+           in scheduling policy registry, returns its code
+Precondition: codeStr is a C-Style string with the name
+              of a registered scheduling policy
+Postcondition: returns code representing scheduling policy
+Exceptions: defaults to FCFS-N code
+Notes: new policies only need a registry entry in schedops.c
 */
 ConfigDataCodes getCpuSchedCode( char *codeStr )
    {
       //initialize function/variables
-            
-         //set up temporary string for testing
-            //function: getStringLength, malloc
-         int strLen = getStringLength( codeStr );
-         char *tempStr = (char *)malloc( strLen + 1);      
-         //set default return to FCFS-N
-         int returnVal = CPU_SCHED_FCFS_N_CODE;
-      //set string to lower case for testing
-         //function: setStrToLowerCase
-      setStrToLowerCase( tempStr, codeStr );
-     
-      //check for SJF-N
-         //function: compareString
-      if( compareString( tempStr, "sjf-n" ) == STR_EQ )
-       {    
-         //set return code to sjf
-         returnVal = CPU_SCHED_SJF_N_CODE;
-       }  
-    
-      //check for SRTF-P
-         //function: compareString
-      if( compareString( tempStr, "srtf-p" ) == STR_EQ )
-       { 
-         //set return code to srtf
-         returnVal = CPU_SCHED_SRTF_P_CODE;
-       }  
-  
-      
-      //check for FCFS-P
-         //function: compareString
-      if( compareString( tempStr, "fcfs-p" ) == STR_EQ )
-       {   
-         //set return code to fcfs
-         returnVal = CPU_SCHED_FCFS_P_CODE;
-       } 
+         //function: findSchedPolicy
+         const SchedPolicy *policy = findSchedPolicy( codeStr );
 
-      //check for RR-P
-         //function: compareString
-      if( compareString( tempStr, "rr-p" ) == STR_EQ )
-       {         
-         //set return code to rr
-         returnVal = CPU_SCHED_RR_P_CODE;
-       }  
+      //check for no registered policy by that name
+      if( policy == NULL )
+       {
+         //default to FCFS-N
+         return CPU_SCHED_FCFS_N_CODE;
+       }
 
-      //free temp string memory
-         //function: free
-      free( tempStr );         
-      //return resulting value
-      return returnVal;
+      //return code of named policy
+      return policy->schedCode;
    }
 
 /*
@@ -557,13 +543,9 @@ Boolean valueInRange( int lineCode, int intVal,
             tempStr = (char *)malloc(strLen + 1);
             setStrToLowerCase( tempStr, stringVal );
               
-           //check for not finding one of the scheduling strings
-              //function: compareString
-           if( compareString( tempStr, "fcfs-n" ) != STR_EQ 
-               && compareString( tempStr, "sjf-n" ) != STR_EQ 
-               && compareString( tempStr, "srtf-p" ) != STR_EQ
-               && compareString( tempStr, "fcfs-p" ) != STR_EQ
-               && compareString( tempStr, "rr-p" ) != STR_EQ  )
+           //check for not finding a registered scheduling policy
+              //function: findSchedPolicy
+           if( findSchedPolicy( tempStr ) == NULL )
             {              
               //set Boolean result to false
               result = False;
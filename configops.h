@@ -27,6 +27,11 @@ typedef enum { CPU_SCHED_SJF_N_CODE,
                CPU_SCHED_FCFS_P_CODE,
                CPU_SCHED_RR_P_CODE, 
                CPU_SCHED_FCFS_N_CODE,
+               CPU_SCHED_MLFQ_P_CODE,
+               CPU_SCHED_CFS_P_CODE,
+               CPU_SCHED_LOTTERY_P_CODE,
+               CPU_SCHED_STRIDE_P_CODE,
+               CPU_SCHED_EDF_P_CODE,
                LOGTO_MONITOR_CODE,
                LOGTO_FILE_CODE,
                LOGTO_BOTH_CODE } ConfigDataCodes; 
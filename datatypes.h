@@ -3,10 +3,14 @@
 #define DATATYPES_H
 
 #include <stdio.h>
+#include <stdint.h>
 
 //GLOBAL CONSTANTS - may be used in other files
 typedef enum { False, True } Boolean;
 
+//simulation time in nanoseconds, formatted as seconds only for output
+typedef int64_t SimTime;
+
 //config data structure
 typedef struct ConfigDataType
    {
@@ -19,25 +23,51 @@ typedef struct ConfigDataType
       int ioCycleRate;
       int logToCode;
       char logToFileName[ 100 ];
+      Boolean virtualTime;     //run on simulated time instead of wall clock,
+                               // set from -vt command line flag
+      Boolean timingWheel;     //keep pending I/O on timing wheel instead of
+                               // heap, set from -tw command line flag
+      int burstAlpha;          //percent weight of newest CPU burst in burst
+                               // predictions, 0 ranks SJF-N and SRTF-P by
+                               // exact times, set from -bp command line flag
+      int pageSize;            //KB per page, 0 runs without paging,
+                               // set from -pg command line flag
+      int pageFrames;          //frames of physical memory when paging, 0
+                               // divides all available memory into frames
+      int pageReplaceCode;     //page replacement policy when paging
+      int placeCode;           //allocator placing mem allocate blocks, 0
+                               // places them where ops ask, set from -pl
+                               // command line flag
+      int compactPercent;      //external fragmentation, in percent, that
+                               // starts compaction after a mem free, 0
+                               // never compacts, set from -cp
    } ConfigDataType;
 
 typedef struct ioData
    {
       char command [ 100 ];    //I/O command, used for output
-      double endTime;          //time the operation should end
+      SimTime endTime;         //time the operation should end
       int processID;           //process that requested this operation
+      struct ProcessControlBlock *process; //PCB of that process
       Boolean reported;        //whether or not this interrupt has been reported
                                // as complete - to prevent duplicate reporting
-      struct ioData *nextNode; //used for interrupt queue
+      int heapIndex;           //position in interrupt queue, kept by heap
    } ioData;
 
 typedef struct memBlock
    {
       int lowerBound; //lower bound of allocated memory block
       int upperBound; //upper bound of allocated memory block
-      struct memBlock *nextAlloc; //pointer to next block as needed
+      int placedBase; //where block is in memory, lower bound unless an
+                      // allocator placed it
    } memBlock;
 
+typedef struct PageEntry
+   {
+      int pageNumber; //virtual page, address divided by page size
+      int frameIndex; //frame holding page, NO_FRAME if not resident
+   } PageEntry;
+
 typedef struct OpCodeType
    {
       int pid;                 //pid, added when PCB is created
@@ -47,7 +77,9 @@ typedef struct OpCodeType
       int intArg2;             //cycles or memory, assumes 4 byte int
       int intArg3;             //memory, assumes 4 byte int
                                //also non/preemption indicator
-      double opEndTime;        //size of time string returned from accessTimer
+                               //also app start tickets
+      int intArg4;             //app start relative deadline in ms
+      SimTime opEndTime;       //time returned from accessTimer
       struct OpCodeType *nextNode; //pointer to next node as needed      
    } OpCodeType;
 
@@ -59,14 +91,52 @@ typedef struct ProcessControlBlock
       int timeRemaining;        //time remaining for process to finish executing
       int cpuCyclesLeft;        //cycles left for current CPU instruction  
       OpCodeType *nextOpCommand;   //pointer to next instruction
-      memBlock *allocdMem;      //pointer to first allocated memory block
+      memBlock *allocdMem;      //allocated memory blocks, sorted by lower
+                                // bound, NULL if process never allocates
+      int numSegments;          //blocks in use
+      int maxSegments;          //room for one block per mem allocate op
+      PageEntry *pageTable;     //every page process may allocate, sorted by
+                                // page number, NULL without paging
+      int numPages;             //entries in page table
+      char logHeader[ 24 ];     //" Process: N, " header for log lines
+      int logHeaderLength;      //length of log header
+      int readyIndex;           //position in ready heap, kept by heap
+      struct ProcessControlBlock *readyPrev; //neighbours in ready ring,
+      struct ProcessControlBlock *readyNext; // NULL when not in it
+      int schedLevel;           //priority level, 0 highest, kept by MLFQ-P
+      int levelCycles;          //cycles run at that level so far
+      long boostEpoch;          //last priority boost level was checked for
+      int niceValue;            //from app start, higher runs less, 0 to 19
+      SimTime virtualRuntime;   //CPU time weighted by nice value, in
+                                // 1024ths of a cycle at nice 0, kept by CFS-P
+      int tickets;              //share of CPU from app start, LOTTERY-P and
+                                // STRIDE-P
+      SimTime passValue;        //stride steps taken so far, kept by STRIDE-P
+      long cpuCyclesRun;        //CPU cycles run over whole simulation
+      long cyclesAtFirstExit;   //CPU cycles run when first process exited,
+                                // while every process still competed
+      int relativeDeadline;     //ms from admission to finish, from app
+                                // start, 0 for none
+      SimTime absoluteDeadline; //time process must finish by, 0 for none
+      long cpuReservation;      //share of CPU held for deadline, in
+                                // millionths, kept by EDF-P
+      Boolean admissionDeferred; //held in NEW until CPU share frees up
+      int predictedBurst;       //expected ms of next CPU burst, averaged
+                                // from bursts run so far
       struct ProcessControlBlock *nextNode; //pointer to next node as needed
+      struct ProcessControlBlock *prevNode; //pointer to previous node
    } ProcessControlBlock;
 
-//Linked list that stores lines to output to file or monitor
+//characters of log text held by each output node
+#define OUTPUT_CHUNK_SIZE 65536
+
+//Linked list that stores lines to output to file, many lines per node
 typedef struct outputNode
    {
-      char currentLine[ 200 ];    //line of text to output
-      struct outputNode *nextNode; //next line of text    
+      char lines[ OUTPUT_CHUNK_SIZE ]; //lines of text, each ending in
+                                      // newline, back to back
+      int used;                       //characters of lines filled
+      struct outputNode *nextNode;    //next node of lines
+      struct outputNode *lastNode;    //node being filled, kept in first node
    } outputNode;
 #endif //DATATYPES_H
@@ -0,0 +1,109 @@
+#include "fenwickops.h"
+
+/*
+Function Name: createFenwickTree
+Algorithm: allocates tree of given number of values, all zero
+Precondition: given number of values
+Postcondition: returns pointer to tree with every value zero
+Exceptions: none
+Notes: none
+*/
+FenwickTree *createFenwickTree( int size )
+{
+   FenwickTree *tree = (FenwickTree *) malloc(sizeof(FenwickTree));
+   int index;
+
+   if(size < 1)
+   {
+      size = 1;
+   }
+
+   tree->partialSums = (long *) malloc(sizeof(long) * (size + 1));
+   for(index = 0; index <= size; index++)
+   {
+      tree->partialSums[ index ] = 0;
+   }
+   tree->size = size;
+   tree->total = 0;
+
+   tree->topStep = 1;
+   while(tree->topStep * 2 <= size)
+   {
+      tree->topStep *= 2;
+   }
+
+   return tree;
+}
+
+/*
+Function Name: clearFenwickTree
+Algorithm: releases tree storage
+Precondition: given tree or NULL
+Postcondition: tree memory freed, returns NULL
+Exceptions: none
+Notes: none
+*/
+FenwickTree *clearFenwickTree( FenwickTree *tree )
+{
+   if(tree != NULL)
+   {
+      free(tree->partialSums);
+      free(tree);
+   }
+   return NULL;
+}
+
+/*
+Function Name: addFenwickValue
+Algorithm: adds delta to every partial sum covering index
+Precondition: given tree, index from zero to size - 1, and delta
+Postcondition: value at index and total are changed by delta
+Exceptions: ignores an index outside the tree
+Notes: O(log n)
+*/
+void addFenwickValue( FenwickTree *tree, int index, long delta )
+{
+   if(index < 0 || index >= tree->size)
+   {
+      return;
+   }
+
+   tree->total += delta;
+   for(index++; index <= tree->size; index += index & -index)
+   {
+      tree->partialSums[ index ] += delta;
+   }
+}
+
+/*
+Function Name: findFenwickIndex
+Algorithm: descends from largest step, skipping each block whose sum
+           does not pass what is left of target
+Precondition: given tree and target from zero to total - 1, values are
+              never negative
+Postcondition: returns smallest index whose running sum passes target
+Exceptions: returns size - 1 for a target at or past total
+Notes: O(log n); with values as ticket counts and a random target, an
+       index comes out in proportion to its value
+*/
+int findFenwickIndex( FenwickTree *tree, long target )
+{
+   int position = 0;
+   int step;
+
+   for(step = tree->topStep; step > 0; step /= 2)
+   {
+      if(position + step <= tree->size
+            && tree->partialSums[ position + step ] <= target)
+      {
+         position += step;
+         target -= tree->partialSums[ position ];
+      }
+   }
+
+   if(position >= tree->size)
+   {
+      return tree->size - 1;
+   }
+   return position;
+}
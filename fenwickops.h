@@ -0,0 +1,25 @@
+//pre-compiler directive
+#ifndef FENWICKOPS_H
+#define FENWICKOPS_H
+
+//header files
+#include "datatypes.h"
+#include <stdlib.h>
+
+//types
+typedef struct FenwickTree
+   {
+      long *partialSums;        //entry i sums values of the i & -i indices
+                                // ending at i, counted from one
+      int size;                 //number of values
+      int topStep;              //largest power of two not above size
+      long total;               //sum of all values
+   } FenwickTree;
+
+//function headers
+void addFenwickValue( FenwickTree *tree, int index, long delta );
+FenwickTree *clearFenwickTree( FenwickTree *tree );
+FenwickTree *createFenwickTree( int size );
+int findFenwickIndex( FenwickTree *tree, long target );
+
+#endif //FENWICKOPS_H
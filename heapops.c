@@ -0,0 +1,282 @@
+#include "heapops.h"
+
+//global constants
+const int NOT_IN_HEAP = -1;
+
+/*
+Function Name: entryBefore
+Algorithm: orders two entries by key, then by tie break value
+Precondition: given two valid heap entries
+Postcondition: returns true if first entry must leave the heap before second
+Exceptions: none
+Notes: local to heap operations
+*/
+static Boolean entryBefore( HeapEntry *first, HeapEntry *second )
+{
+   if(first->key != second->key)
+   {
+      return first->key < second->key;
+   }
+   return first->tieBreak < second->tieBreak;
+}
+
+/*
+Function Name: placeEntry
+Algorithm: stores entry at given index and updates its handle
+Precondition: given heap, valid index, and entry
+Postcondition: entry and its owner's handle agree on position
+Exceptions: none
+Notes: local to heap operations
+*/
+static void placeEntry( MinHeap *heap, int index, HeapEntry entry )
+{
+   heap->entries[ index ] = entry;
+
+   if(entry.handle != NULL)
+   {
+      *entry.handle = index;
+   }
+}
+
+/*
+Function Name: siftUp
+Algorithm: moves entry toward root while it belongs before its parent
+Precondition: given heap and index of possibly misplaced entry
+Postcondition: heap order restored along path to root
+Exceptions: none
+Notes: local to heap operations
+*/
+static void siftUp( MinHeap *heap, int index )
+{
+   HeapEntry moving = heap->entries[ index ];
+   int parent;
+
+   while(index > 0)
+   {
+      parent = (index - 1) / 2;
+
+      if(entryBefore(&moving, &heap->entries[ parent ]) == False)
+      {
+         break;
+      }
+      placeEntry(heap, index, heap->entries[ parent ]);
+      index = parent;
+   }
+   placeEntry(heap, index, moving);
+}
+
+/*
+Function Name: siftDown
+Algorithm: moves entry toward leaves while a child belongs before it
+Precondition: given heap and index of possibly misplaced entry
+Postcondition: heap order restored below index
+Exceptions: none
+Notes: local to heap operations
+*/
+static void siftDown( MinHeap *heap, int index )
+{
+   HeapEntry moving = heap->entries[ index ];
+   int child;
+
+   while((child = 2 * index + 1) < heap->size)
+   {
+      //pick earlier of two children
+      if(child + 1 < heap->size
+            && entryBefore(&heap->entries[ child + 1 ],
+                                         &heap->entries[ child ]) == True)
+      {
+         child++;
+      }
+
+      if(entryBefore(&heap->entries[ child ], &moving) == False)
+      {
+         break;
+      }
+      placeEntry(heap, index, heap->entries[ child ]);
+      index = child;
+   }
+   placeEntry(heap, index, moving);
+}
+
+/*
+Function Name: createMinHeap
+Algorithm: allocates empty heap with room for given number of entries
+Precondition: given starting capacity, grows as needed
+Postcondition: returns pointer to empty heap
+Exceptions: none
+Notes: none
+*/
+MinHeap *createMinHeap( int initialCapacity )
+{
+   MinHeap *heap = (MinHeap *) malloc(sizeof(MinHeap));
+
+   if(initialCapacity < 1)
+   {
+      initialCapacity = 1;
+   }
+
+   heap->entries = (HeapEntry *) malloc(sizeof(HeapEntry) * initialCapacity);
+   heap->size = 0;
+   heap->capacity = initialCapacity;
+
+   return heap;
+}
+
+/*
+Function Name: clearMinHeap
+Algorithm: releases heap storage
+Precondition: given heap or NULL
+Postcondition: heap memory freed, returns NULL
+Exceptions: none
+Notes: items are owned by the caller and are not freed
+*/
+MinHeap *clearMinHeap( MinHeap *heap )
+{
+   if(heap != NULL)
+   {
+      free(heap->entries);
+      free(heap);
+   }
+   return NULL;
+}
+
+/*
+Function Name: heapIsEmpty
+Algorithm: checks entry count
+Precondition: given heap
+Postcondition: returns true if heap holds no entries
+Exceptions: none
+Notes: none
+*/
+Boolean heapIsEmpty( MinHeap *heap )
+{
+   return heap->size == 0;
+}
+
+/*
+Function Name: insertHeapItem
+Algorithm: appends entry at end of array and sifts it up
+Precondition: given heap, ordering values, item, and optional handle
+Postcondition: item is in heap, handle holds its index
+Exceptions: none
+Notes: doubles array when full, O(log n)
+*/
+void insertHeapItem( MinHeap *heap, SimTime key, long tieBreak,
+                                                 void *item, int *handle )
+{
+   HeapEntry newEntry;
+
+   if(heap->size == heap->capacity)
+   {
+      heap->capacity *= 2;
+      heap->entries = (HeapEntry *) realloc(heap->entries,
+                                     sizeof(HeapEntry) * heap->capacity);
+   }
+
+   newEntry.key = key;
+   newEntry.tieBreak = tieBreak;
+   newEntry.item = item;
+   newEntry.handle = handle;
+
+   placeEntry(heap, heap->size, newEntry);
+   heap->size++;
+   siftUp(heap, heap->size - 1);
+}
+
+/*
+Function Name: peekHeapKey
+Algorithm: reads key of root entry
+Precondition: given non empty heap
+Postcondition: returns smallest key in heap
+Exceptions: none
+Notes: O(1)
+*/
+SimTime peekHeapKey( MinHeap *heap )
+{
+   return heap->entries[ 0 ].key;
+}
+
+/*
+Function Name: peekHeapItem
+Algorithm: reads item of root entry
+Precondition: given heap
+Postcondition: returns item with smallest key, or NULL if heap is empty
+Exceptions: none
+Notes: O(1)
+*/
+void *peekHeapItem( MinHeap *heap )
+{
+   if(heap->size == 0)
+   {
+      return NULL;
+   }
+   return heap->entries[ 0 ].item;
+}
+
+/*
+Function Name: removeHeapItem
+Algorithm: moves last entry into removed slot and restores order
+Precondition: given heap and index held by an item's handle
+Postcondition: item is no longer in heap, its handle is NOT_IN_HEAP
+Exceptions: returns NULL for an index outside the heap
+Notes: O(log n)
+*/
+void *removeHeapItem( MinHeap *heap, int handle )
+{
+   HeapEntry removed;
+
+   if(handle < 0 || handle >= heap->size)
+   {
+      return NULL;
+   }
+
+   removed = heap->entries[ handle ];
+   heap->size--;
+
+   //fill hole with last entry, which may need to go either way
+   if(handle < heap->size)
+   {
+      placeEntry(heap, handle, heap->entries[ heap->size ]);
+      siftUp(heap, handle);
+      siftDown(heap, handle);
+   }
+
+   if(removed.handle != NULL)
+   {
+      *removed.handle = NOT_IN_HEAP;
+   }
+   return removed.item;
+}
+
+/*
+Function Name: popHeapItem
+Algorithm: removes root entry
+Precondition: given heap
+Postcondition: returns item with smallest key, or NULL if heap is empty
+Exceptions: none
+Notes: O(log n)
+*/
+void *popHeapItem( MinHeap *heap )
+{
+   return removeHeapItem(heap, 0);
+}
+
+/*
+Function Name: updateHeapKey
+Algorithm: changes key of entry in place and restores order
+Precondition: given heap, index held by an item's handle, and new key
+Postcondition: entry sits in its correct position for new key
+Exceptions: ignores an index outside the heap
+Notes: O(log n)
+*/
+void updateHeapKey( MinHeap *heap, int handle, SimTime key )
+{
+   if(handle < 0 || handle >= heap->size)
+   {
+      return;
+   }
+
+   heap->entries[ handle ].key = key;
+   siftUp(heap, handle);
+   siftDown(heap, handle);
+}
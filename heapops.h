@@ -0,0 +1,40 @@
+//pre-compiler directive
+#ifndef HEAPOPS_H
+#define HEAPOPS_H
+
+//header files
+#include "datatypes.h"
+#include <stdlib.h>
+
+//constants
+extern const int NOT_IN_HEAP;
+
+//types
+typedef struct HeapEntry
+   {
+      SimTime key;      //primary ordering value, smallest comes out first
+      long tieBreak;    //secondary ordering value for equal keys
+      void *item;       //caller's data, not owned by the heap
+      int *handle;      //mirrors entry's current index, may be NULL
+   } HeapEntry;
+
+typedef struct MinHeap
+   {
+      HeapEntry *entries;
+      int size;
+      int capacity;
+   } MinHeap;
+
+//function headers
+MinHeap *clearMinHeap( MinHeap *heap );
+MinHeap *createMinHeap( int initialCapacity );
+Boolean heapIsEmpty( MinHeap *heap );
+void insertHeapItem( MinHeap *heap, SimTime key, long tieBreak,
+                                                void *item, int *handle );
+SimTime peekHeapKey( MinHeap *heap );
+void *peekHeapItem( MinHeap *heap );
+void *popHeapItem( MinHeap *heap );
+void *removeHeapItem( MinHeap *heap, int handle );
+void updateHeapKey( MinHeap *heap, int handle, SimTime key );
+
+#endif //HEAPOPS_H
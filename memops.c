@@ -1,38 +1,91 @@
 #include "datatypes.h"
 #include "StringUtils.h"
 #include "memops.h"
+#include <string.h>
 
 /*
-Function Name: addToMemList
-Algorithm: adds to end of linked list
-Preconditon: given pointer to front of queue or null
-Postcondition: creates new linked list or appends node
-               to end of linked list
+Function Name: findSegment
+Algorithm: binary searches process's blocks for last one whose lower
+           bound is not above given address
+Precondition: given process and address
+Postcondition: returns index of that block, or -1 if every block starts
+               above address
 Exceptions: none
-Notes: none
-*/ 
-memBlock *addToMemList( memBlock *localPtr, memBlock *newBlock)
+Notes: local to memory operations; O(log k) for k blocks
+*/
+static int findSegment( ProcessControlBlock *pcb, int address )
 {
-   //check for local ptr assigned to null
-   if(localPtr == NULL)
+   int low = 0;
+   int high = pcb->numSegments - 1;
+   int middle;
+   int found = -1;
+
+   while(low <= high)
    {
-      //allocate memory for new node
-      localPtr = (memBlock *) malloc(sizeof(memBlock));
-      //assign all values to newly created node
-      localPtr->lowerBound = newBlock->lowerBound;
-      localPtr->upperBound = newBlock->upperBound;
+      middle = (low + high) / 2;
+      if(pcb->allocdMem[ middle ].lowerBound <= address)
+      {
+         found = middle;
+         low = middle + 1;
+      }
+      else
+      {
+         high = middle - 1;
+      }
+   }
+   return found;
+}
 
-      //assign next node to null
-      localPtr->nextAlloc = NULL;
+/*
+Function Name: getBlockPages
+Algorithm: divides first and last address of block by page size
+Precondition: given block and page size
+Postcondition: first and last page block uses are returned as parameters
+Exceptions: block of no size still uses page of its lower bound
+Notes: local to memory operations; matches pages page table was built
+       with for block's mem allocate
+*/
+static void getBlockPages( memBlock *block, int pageSize,
+                                          int *firstPage, int *lastPage )
+{
+   *firstPage = block->lowerBound / pageSize;
+   *lastPage = *firstPage;
+   if(block->upperBound > block->lowerBound)
+   {
+      *lastPage = (block->upperBound - 1) / pageSize;
+   }
+}
 
-      return localPtr;
+/*
+Function Name: verifyPrivateAlloc
+Algorithm: finds process's block with highest lower bound not above top
+           of request, checking if process has not already allocated
+           memory requested
+Precondition: given process and op code with memory allocation request
+Postcondition: returns true if request is within limits of memory, when
+               paging, and does not overlap a block of process, false
+               otherwise
+Exceptions: none
+Notes: local to memory operations; when paging or placing, each process
+       has its own address space and only its own blocks can get in the
+       way; O(log k)
+*/
+static Boolean verifyPrivateAlloc( ProcessControlBlock *pcb,
+                             OpCodeType *memRequest, ConfigDataType *configPtr )
+{
+   int requestTop = memRequest->intArg2 + memRequest->intArg3;
+   int segment;
 
+   //memory size bounds each address space when paging, when placing
+   // allocator's room bounds it instead
+   if(configPtr->pageSize > 0 && requestTop > configPtr->memAvailable)
+   {
+      return False;
    }
 
-  //assume not at end of list
-  localPtr->nextAlloc = addToMemList(localPtr->nextAlloc, newBlock);
-  return localPtr;
-   
+   segment = findSegment(pcb, requestTop);
+   return segment < 0
+          || memRequest->intArg2 > pcb->allocdMem[ segment ].upperBound;
 }
 
 /*
@@ -43,31 +96,18 @@ Algorithm: checks if memory request is valid and
 Precondition: given process and op code with request for memory
 Postcondition: returns true upon successful access or false if 
                unsuccessful access
+Notes: blocks of a process never overlap, so only last block starting
+       at or below request can hold it; O(log k)
 */
 Boolean accessMemory(ProcessControlBlock *currentProcess, 
                        OpCodeType *memRequest)
 {
-    //initialize variables
-    memBlock *memAllocs = currentProcess->allocdMem;
-
-    //iterate through allocated memory for given process
-    while(memAllocs != NULL)
-    {
-      //check if request >= lower bound and <= upper boud of this mem block
-      if(memRequest->intArg2 >= memAllocs->lowerBound && 
-          (memRequest->intArg2 + memRequest->intArg3) <= memAllocs->upperBound)
-      {
-         //if yes, return true 
-         return True;
-      }
-         //if not, move on to next allocated block
-      memAllocs = memAllocs->nextAlloc;
-
-     } 
-     //end loop
+    //find only block of process that could hold request
+    int segment = findSegment(currentProcess, memRequest->intArg2);
 
-   //return false upon loop end
-   return False;
+    //check if request <= upper bound of that block
+    return segment >= 0 && (memRequest->intArg2 + memRequest->intArg3) 
+                         <= currentProcess->allocdMem[ segment ].upperBound;
 }
 
 /*
@@ -78,23 +118,66 @@ Algorithm: checks if requested memory allocation
 Precondition: given process control block and op 
               code with memory allocation request
 Postcondition: allocates memory or returns error
+Notes: process has room for one block per mem allocate op, so array
+       never grows; when paging or placing, blocks are private to process
+       and stay out of index of live blocks; when placing, op's base only
+       names block to process, and allocator chooses where it goes
 */
 Boolean allocateMemory(ProcessControlBlock **currentProcess,
-                                    ProcessControlBlock *queueHead, 
+                                    OrderedTree *memIndex, 
+                                    Placement *placement,
                                     OpCodeType* memRequest,
                                     ConfigDataType *configPtr)
 {
+   MemInterval *interval;
+   ProcessControlBlock *pcb = *currentProcess;
+   Boolean validRequest;
+   int placedBase = memRequest->intArg2;
+   int segment;
+
    //check if allocation request is valid
-   if(verifyMemAlloc(*currentProcess, queueHead, memRequest,
-                             configPtr) == True)
+   if(configPtr->pageSize > 0 || placement != NULL)
+   {
+      validRequest = verifyPrivateAlloc(pcb, memRequest, configPtr);
+   }
+   else
+   {
+      validRequest = verifyMemAlloc(memIndex, memRequest, configPtr);
+   }
+
+   //and that allocator has room for it, if placing
+   if(validRequest == True && placement != NULL)
+   {
+      placedBase = placeBlock(placement, memRequest->intArg3);
+      validRequest = placedBase != NO_PLACEMENT;
+   }
+
+   if(validRequest == True)
    {
 
-      //if yes, add memory allocation to current PCB
-      memBlock *newMem = (memBlock*)malloc(sizeof(memBlock));
-      newMem->lowerBound = memRequest->intArg2;
-      newMem->upperBound = (memRequest->intArg2 + memRequest->intArg3); 
-      (*currentProcess)->allocdMem = addToMemList((*currentProcess)->allocdMem, 
-                                                 newMem);
+      //if yes, add memory allocation to current PCB, in place
+      segment = findSegment(pcb, memRequest->intArg2) + 1;
+      memmove(&pcb->allocdMem[ segment + 1 ], &pcb->allocdMem[ segment ],
+                         sizeof(memBlock) * (pcb->numSegments - segment));
+      pcb->allocdMem[ segment ].lowerBound = memRequest->intArg2;
+      pcb->allocdMem[ segment ].upperBound = 
+                                (memRequest->intArg2 + memRequest->intArg3);
+      pcb->allocdMem[ segment ].placedBase = placedBase;
+      pcb->numSegments++;
+
+      //blocks of one address space need no index
+      if(configPtr->pageSize > 0 || placement != NULL)
+      {
+         return True;
+      }
+
+      //and to index of every live block, by lower bound
+      interval = (MemInterval *) malloc(sizeof(MemInterval));
+      interval->lowerBound = pcb->allocdMem[ segment ].lowerBound;
+      interval->upperBound = pcb->allocdMem[ segment ].upperBound;
+      interval->ownerPid = pcb->processID;
+      insertTreeItem(memIndex, interval->lowerBound, interval->ownerPid,
+                                                                 interval);
       //return true
       return True;
    }
@@ -104,85 +187,159 @@ Boolean allocateMemory(ProcessControlBlock **currentProcess,
 }
 
 /*
-Function Name: clearMemQueue
-Algorithm: recursively iterates through process linked list,
-           returns memory to OS from the bottom of the list upward
-Precondition: linked list, with or without data
-Postcondition: all node memory, if any, is returned to OS,
-               return pointer (head) is set to nulll
+Function name: freeMemory
+Algorithm: finds process's block starting at given base, takes it out of
+           allocator or index of live blocks, gives back frames of pages
+           only it used, and closes gap it leaves in process's block array
+Precondition: given process, memory index of every live block, paged
+              memory or NULL, placement or NULL, and op code with memory
+              free request
+Postcondition: returns true if block was freed, false if process has no
+               block starting at base
+Exceptions: none
+Notes: blocks of a process never overlap, but a page can hold end of one
+       and start of next, so only neighbours can keep a page in use;
+       O(k) for k blocks of process, to close gap, plus O(log n)
+*/
+Boolean freeMemory(ProcessControlBlock *pcb, OrderedTree *memIndex,
+                           PagedMemory *pagedMemory, Placement *placement,
+                                                     OpCodeType *memRequest)
+{
+   int segment = findSegment(pcb, memRequest->intArg2);
+   memBlock *block;
+   int firstPage, lastPage;
+   int neighbourFirst, neighbourLast;
+
+   if(segment < 0 || pcb->allocdMem[ segment ].lowerBound 
+                                                   != memRequest->intArg2)
+   {
+      return False;
+   }
+
+   //give memory back where it came from, index has none when private
+   block = &pcb->allocdMem[ segment ];
+   if(placement != NULL)
+   {
+      releaseBlock(placement, block->placedBase,
+                                       block->upperBound - block->lowerBound);
+   }
+   free(removeTreeItem(memIndex, block->lowerBound, pcb->processID));
+
+   //free frames of pages neither neighbour shares
+   if(pagedMemory != NULL)
+   {
+      getBlockPages(block, pagedMemory->pageSize, &firstPage, &lastPage);
+      if(segment > 0)
+      {
+         getBlockPages(&pcb->allocdMem[ segment - 1 ],
+                      pagedMemory->pageSize, &neighbourFirst, &neighbourLast);
+         if(neighbourLast == firstPage)
+         {
+            firstPage++;
+         }
+      }
+      if(segment < pcb->numSegments - 1)
+      {
+         getBlockPages(&pcb->allocdMem[ segment + 1 ],
+                      pagedMemory->pageSize, &neighbourFirst, &neighbourLast);
+         if(neighbourFirst == lastPage)
+         {
+            lastPage--;
+         }
+      }
+      releasePages(pagedMemory, pcb, firstPage, lastPage);
+   }
+
+   pcb->numSegments--;
+   memmove(&pcb->allocdMem[ segment ], &pcb->allocdMem[ segment + 1 ],
+                         sizeof(memBlock) * (pcb->numSegments - segment));
+   return True;
+}
+
+/*
+Function Name: clearMemIndex
+Algorithm: releases every interval left in index, then index
+Precondition: given memory index or NULL
+Postcondition: index memory freed, returns NULL
 Exceptions: none
 Notes: none
 */
-memBlock *clearMemQueue( memBlock *localPtr )
-   { 
-      //check for local pointer not set to null(list not empty)
-      if( localPtr != NULL )
-      {      
-         //call recursive function with next pointer
-          clearMemQueue( localPtr->nextAlloc );      
-         //after recursive call, release memory to OS
-            //function: free
-         free( localPtr );   
-         //set local pointer to null
-         localPtr = NULL;
-      }   
-      //return null to calling function
-      return NULL;
+OrderedTree *clearMemIndex( OrderedTree *memIndex )
+{
+   MemInterval *interval;
+
+   if(memIndex != NULL)
+   {
+      while((interval = (MemInterval *) popTreeMin(memIndex)) != NULL)
+      {
+         free(interval);
+      }
+      memIndex = clearOrderedTree(memIndex);
    }
+   return NULL;
+}
+
+/*
+Function name: releaseProcessMemory
+Algorithm: takes each of process's blocks out of memory index, then
+           releases process's block array
+Precondition: given memory index and process
+Postcondition: process holds no memory, its blocks can be allocated again
+Exceptions: none
+Notes: O(k log n) for k blocks of process among n live blocks
+*/
+void releaseProcessMemory( OrderedTree *memIndex, ProcessControlBlock *pcb )
+{
+   int segment;
 
+   for(segment = 0; segment < pcb->numSegments; segment++)
+   {
+      free(removeTreeItem(memIndex, pcb->allocdMem[ segment ].lowerBound,
+                                                          pcb->processID));
+   }
+   free(pcb->allocdMem);
+   pcb->allocdMem = NULL;
+   pcb->numSegments = 0;
+}
 
 /*
 Function name: verifyMemAlloc
-Algorithm: iterates through process control blocks, 
-           checking if memory requested has not already been allocated
-Precondition: given valid process queue and current process as well as op
+Algorithm: finds live block with highest lower bound not above top of
+           request, checking if memory requested has not already been
+           allocated
+Precondition: given memory index of every live block and op
               code with memory allocation request
 Postcondition: returns true if memory has not yet been allocated and is 
                within limits of memory or false if memory has either already
                been allocated or is outside limits
+Notes: live blocks never overlap or touch, so blocks in lower bound order
+       are in upper bound order too, and only that one block can reach
+       the request; O(log n)
 */
-Boolean verifyMemAlloc(ProcessControlBlock *currentProcess,
-                         ProcessControlBlock *queueHead,
+Boolean verifyMemAlloc(OrderedTree *memIndex,
                             OpCodeType *memRequest,
                              ConfigDataType *configPtr)
 {
    //initialize variables
-   ProcessControlBlock *tempPtr = queueHead;
-   memBlock *memPtr;
+   int requestTop = memRequest->intArg2 + memRequest->intArg3;
+   MemInterval *nearest;
 
 
    //check if base + offset > amt in config file
-   if((memRequest->intArg2 + memRequest->intArg3) > configPtr->memAvailable)
+   if(requestTop > configPtr->memAvailable)
    {
       //if so, return false
       return False;
    }
-   //iterate through PCBs
-   while(tempPtr != NULL)
-   {
-      memPtr = tempPtr->allocdMem;
-
-      //iterate through memory allocations for current process
-      while(memPtr != NULL)
-      {
-         //if requested allocation overlaps with already allocated memory, 
-         //return false
-         if((memRequest->intArg2 <= memPtr->upperBound) &&
-             ((memRequest->intArg2 + memRequest->intArg3) >= memPtr->lowerBound))
-         {
-            return False;
-         }
-         memPtr = memPtr->nextAlloc;
-
-
-      }
-
-      tempPtr = tempPtr->nextNode;
 
+   //if requested allocation overlaps with already allocated memory, 
+   //return false
+   nearest = (MemInterval *) findTreeFloor(memIndex, requestTop);
+   if(nearest != NULL && memRequest->intArg2 <= nearest->upperBound)
+   {
+      return False;
    }
-   //end loop
-   
 
-   //return true upon loop exit 
+   //return true otherwise
    return True;
 }
\ No newline at end of file
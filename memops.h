@@ -4,17 +4,32 @@
 
 #include "datatypes.h"
 #include "StringUtils.h"
+#include "treeops.h"
+#include "placeops.h"
+#include "pageops.h"
+
+//types
+typedef struct MemInterval
+   {
+      int lowerBound;           //lower bound of allocated memory block
+      int upperBound;           //upper bound of allocated memory block
+      int ownerPid;             //process holding block
+   } MemInterval;
 
 Boolean accessMemory(ProcessControlBlock *currentProcess, 
                        OpCodeType *memRequest);
-memBlock *addToMemList( memBlock *localPtr, memBlock *newBlock);
 Boolean allocateMemory(ProcessControlBlock **currentProcess,
-                                    ProcessControlBlock *queueHead, 
+                                    OrderedTree *memIndex, 
+                                    Placement *placement,
                                           OpCodeType* memRequest,
                                      ConfigDataType *configPtr);
-memBlock *clearMemQueue( memBlock *localPtr );
-Boolean verifyMemAlloc(ProcessControlBlock *currentProcess,
-                         ProcessControlBlock *queueHead,
+OrderedTree *clearMemIndex( OrderedTree *memIndex );
+Boolean freeMemory(ProcessControlBlock *pcb, OrderedTree *memIndex,
+                           PagedMemory *pagedMemory, Placement *placement,
+                                                   OpCodeType *memRequest);
+void releaseProcessMemory( OrderedTree *memIndex,
+                                       ProcessControlBlock *pcb );
+Boolean verifyMemAlloc(OrderedTree *memIndex,
                          OpCodeType *memRequest,
                          ConfigDataType *configPtr);
 
@@ -1,4 +1,5 @@
 #include "metadataops.h"
+#include "simtimer.h"
 
 //locally used constants
 
@@ -27,6 +28,7 @@ OpCodeType *addNode( OpCodeType *localPtr, OpCodeType *newNode )
          copyString( localPtr->strArg1, newNode->strArg1 );
          localPtr->intArg2 = newNode->intArg2;
          localPtr->intArg3 = newNode->intArg3;
+         localPtr->intArg4 = newNode->intArg4;
          localPtr->opEndTime = newNode->opEndTime;
 
          //assign next pointer to null
@@ -85,6 +87,9 @@ Notes: none
 */
 void displayMetaData( OpCodeType *localPtr )
    {
+      //initialize variables
+      char timeString[ STD_STR_LEN ];
+
       //display title, with underline
          //function: printf
       printf( "Meta-Data File Display\n" );
@@ -132,8 +137,9 @@ void displayMetaData( OpCodeType *localPtr )
          printf( "/arg3: %d", localPtr->intArg3 );
             
          //print op end time
-            //function: printf
-         printf( "/op end time: %8.6f", localPtr->opEndTime );
+            //function: timeToString, printf
+         timeToString( localPtr->opEndTime, timeString );
+         printf( "/op end time: %8s", timeString );
             
          //end line
            //function : printf 
@@ -237,6 +243,7 @@ Boolean getMetaData( char *fileName,
          Boolean returnState = True;
          OpCodeType *newNodePtr;
          OpCodeType *localHeadPtr = NULL;
+         OpCodeType *localTailPtr = NULL;
          FILE *fileAccessPtr;
          
       //initialize op code data pointer in case of return error
@@ -315,9 +322,17 @@ Boolean getMetaData( char *fileName,
       //  (while complete op commands are found)
       while( accessResult == COMPLETE_OPCMD_FOUND_MSG )
       {     
-         //add the new op command to the linked list
+         //add the new op command behind last one, not from head
             //function: addNode
-         localHeadPtr = addNode( localHeadPtr, newNodePtr );
+         localTailPtr = addNode( localTailPtr, newNodePtr );
+         if( localHeadPtr == NULL )
+         {
+            localHeadPtr = localTailPtr;
+         }
+         else
+         {
+            localTailPtr = localTailPtr->nextNode;
+         }
 
          //get a new op command
             //function: getOpCommand
@@ -335,9 +350,13 @@ Boolean getMetaData( char *fileName,
          //check for start and end op code counts equal
          if( startCount == endCount )
          {  
-            //add the last node to the linked list
+            //add the last node behind last one, not from head
                //function: addNode
-            localHeadPtr = addNode( localHeadPtr, newNodePtr );
+            localTailPtr = addNode( localTailPtr, newNodePtr );
+            if( localHeadPtr == NULL )
+            {
+               localHeadPtr = localTailPtr;
+            }
 
             //set access result to no error for later operation
             accessResult = NO_ERR;
@@ -470,7 +489,8 @@ int getOpCommand( FILE *filePtr, OpCodeType *inData)
       inData->inOutArg[ 0 ] = NULL_CHAR;
       inData->intArg2 = 0;
       inData->intArg3 = 0;
-      inData->opEndTime = 0.0;
+      inData->intArg4 = 0;
+      inData->opEndTime = 0;
       inData->nextNode = NULL;
 
       //check for device command
@@ -519,7 +539,8 @@ int getOpCommand( FILE *filePtr, OpCodeType *inData)
          return LAST_OPCMD_FOUND_MSG;
       }         
 
-      //check for app start seconds argument
+      //check for app start nice value, optional tickets and deadline
+      // arguments
          //function: compareString
       if( compareString( inData->command, "app" ) == STR_EQ
           && compareString( inData->strArg1, "start" ) == STR_EQ )
@@ -537,6 +558,44 @@ int getOpCommand( FILE *filePtr, OpCodeType *inData)
          }  
          //set first int argument to number
          inData->intArg2 = numBuffer;
+
+         //check for optional tickets argument
+            //function: hasNextArg
+         if( hasNextArg( strBuffer, runningStringIndex ) == True )
+         {
+            //get number argument
+               //function: getNumberArg
+            runningStringIndex = getNumberArg( &numBuffer, 
+                                             strBuffer, runningStringIndex );
+
+            //check for failed number access
+            if( numBuffer <= BAD_ARG_VAL )
+            {
+               //set failure flag
+               arg3FailureFlag = True;
+            }
+            //set second int argument to number
+            inData->intArg3 = numBuffer;
+         }
+
+         //check for optional deadline argument
+            //function: hasNextArg
+         if( hasNextArg( strBuffer, runningStringIndex ) == True )
+         {
+            //get number argument
+               //function: getNumberArg
+            runningStringIndex = getNumberArg( &numBuffer, 
+                                             strBuffer, runningStringIndex );
+
+            //check for failed number access
+            if( numBuffer <= BAD_ARG_VAL )
+            {
+               //set failure flag
+               arg3FailureFlag = True;
+            }
+            //set third int argument to number
+            inData->intArg4 = numBuffer;
+         }
       }
       
       //check for cpu cycle time
@@ -594,19 +653,22 @@ int getOpCommand( FILE *filePtr, OpCodeType *inData)
          //set first int argument to number
          inData->intArg2 = numBuffer;
          
-         //get number argument for offset
-            //function: getNumberArg
-         runningStringIndex = getNumberArg( &numBuffer,
+         //get number argument for offset, free needs only base
+            //function: compareString, getNumberArg
+         if( compareString( inData->strArg1, "free" ) != STR_EQ )
+         {
+            runningStringIndex = getNumberArg( &numBuffer,
                                               strBuffer, runningStringIndex );
          
-         //check for failed number access
-         if( numBuffer <= BAD_ARG_VAL )
-         {         
-            //set failure flag
-            arg3FailureFlag = True;
-         }   
-         //set second int argument to number
-         inData->intArg3 = numBuffer;
+            //check for failed number access
+            if( numBuffer <= BAD_ARG_VAL )
+            {         
+               //set failure flag
+               arg3FailureFlag = True;
+            }   
+            //set second int argument to number
+            inData->intArg3 = numBuffer;
+         }
       }
       //check int args for upload failure
       if( arg2FailureFlag == True || arg3FailureFlag == True )
@@ -672,6 +734,28 @@ int getNumberArg( int *number, char *inputStr, int index )
     return index; 
    }
 
+/*
+Function Name: hasNextArg
+Algorithm: skips white space and commas, checks for end of string
+Precondition: given op command input string and index after last argument
+Postcondition: returns true if another argument follows
+Exceptions: none
+Notes: lets trailing arguments be left out
+*/
+Boolean hasNextArg( char *inputStr, int index )
+   {
+      //loop to skip white space and commas, stopping at end of string
+      while( ( inputStr[ index ] <= SPACE && inputStr[ index ] != NULL_CHAR )
+             || inputStr[ index ] == COMMA )
+      {
+         //increment index
+         index++;
+      }
+
+      //return whether anything is left
+      return inputStr[ index ] != NULL_CHAR;
+   }
+
 /*
 Function Name: getStringArg
 Algorithm: skips leading white space,
@@ -802,6 +886,7 @@ Boolean verifyFirstStringArg( char *strArg )
           || compareString( strArg, "allocate" ) == STR_EQ
           || compareString( strArg, "end" ) == STR_EQ
           || compareString( strArg, "ethernet" ) == STR_EQ
+          || compareString( strArg, "free" ) == STR_EQ
           || compareString( strArg, "hard drive" ) == STR_EQ
           || compareString( strArg, "keyboard" ) == STR_EQ
           || compareString( strArg, "monitor" ) == STR_EQ
@@ -31,6 +31,7 @@ Boolean getMetaData( char *fileName,
                       OpCodeType **opCodeDataHead, char *endStateMsg);
 int getOpCommand( FILE *filePtr, OpCodeType *inData);
 int getNumberArg( int *number, char *inputStr, int index );
+Boolean hasNextArg( char *inputStr, int index );
 int getStringArg( char *strArg, char *inputStr, int index );
 Boolean isDigit( char testChar );
 int updateEndCount( int count, char *opString );
@@ -1,65 +1,165 @@
 #include "datatypes.h"
 #include "configops.h"
 #include "StringUtils.h"
+#include "outputops.h"
 /*
 Function Name: addToOutputList
-Algorithm: adds to end of linked list
+Algorithm: prints line to monitor, then copies it and a newline behind
+           text of last node, found through pointer kept in first node,
+           adding a node when last one may not hold another line
 Preconditon: given pointer to front of queue or null
-Postcondition: creates new linked list or appends node
+Postcondition: creates new linked list or appends line
                to end of linked list
-Exceptions: none
-Notes: none
+Exceptions: line is only kept when it will be written to file
+Notes: O(1), no walk down list; nodes hold many lines, so a new node is
+       allocated only once per OUTPUT_CHUNK_SIZE characters
 */ 
 outputNode *addToOutputList( outputNode *localPtr, char *newLine, ConfigDataType *configPtr )
 {
-   //check for local ptr assigned to null
-   if(localPtr == NULL)
+   outputNode *lastPtr = NULL;
+   int index = 0;
+
+   if(configPtr->logToCode==LOGTO_MONITOR_CODE || configPtr->logToCode==LOGTO_BOTH_CODE)
    {
-      //allocate memory for new node
-      localPtr = (outputNode *) malloc(sizeof(outputNode));
-      //assign all values to newly created node
-      copyString(localPtr->currentLine, newLine);
-      if(configPtr->logToCode==LOGTO_MONITOR_CODE || configPtr->logToCode==LOGTO_BOTH_CODE)
+      printf("%s \n", newLine);
+   }
+
+   //nothing reads lines back unless they go to file
+   if(configPtr->logToCode != LOGTO_FILE_CODE 
+                               && configPtr->logToCode != LOGTO_BOTH_CODE)
+   {
+      return localPtr;
+   }
+
+   if(localPtr != NULL)
+   {
+      lastPtr = localPtr->lastNode;
+   }
+
+   //add node when list is empty or last node may not hold a full line
+   if(lastPtr == NULL || lastPtr->used > OUTPUT_CHUNK_SIZE - MAX_STR_LEN - 1)
+   {
+      lastPtr = (outputNode *) malloc(sizeof(outputNode));
+      lastPtr->used = 0;
+      lastPtr->nextNode = NULL;
+      lastPtr->lastNode = NULL;
+
+      //check for local ptr assigned to null, new node starts list
+      if(localPtr == NULL)
+      {
+         localPtr = lastPtr;
+      }
+
+      //otherwise link it behind last node
+      else
       {
-         printf("%s \n", newLine);
+         localPtr->lastNode->nextNode = lastPtr;
       }
+      localPtr->lastNode = lastPtr;
+   }
 
-      //assign next node to null
-      localPtr->nextNode = NULL;
+   //copy line in one pass, then end it
+   while(newLine[ index ] != NULL_CHAR && index < MAX_STR_LEN - 1)
+   {
+      lastPtr->lines[ lastPtr->used ] = newLine[ index ];
+      lastPtr->used++;
+      index++;
+   }
+   lastPtr->lines[ lastPtr->used ] = '\n';
+   lastPtr->used++;
 
-      return localPtr;
+   return localPtr;
+}
+
+/*
+Function Name: appendIntToLine
+Algorithm: writes decimal digits of value at end of line
+Precondition: line holds lineLength characters
+Postcondition: digits and null character are added,
+               new line length is returned
+Exceptions: stops at MAX_STR_LEN like appendToLine
+Notes: replaces sprintf into a buffer followed by concatenateString
+*/
+int appendIntToLine( char *line, int lineLength, int value )
+{
+   char digits[ 12 ];
+   int numDigits = 0;
+   unsigned int magnitude = (unsigned int) value;
 
+   //add sign
+   if(value < 0 && lineLength < MAX_STR_LEN - 1)
+   {
+      line[ lineLength ] = '-';
+      lineLength++;
+      magnitude = 0u - magnitude;
+   }
+
+   //collect digits, lowest first
+   do
+   {
+      digits[ numDigits ] = (char) ( magnitude % 10 + '0' );
+      numDigits++;
+      magnitude /= 10;
+   }while(magnitude > 0);
+
+   //write digits highest first
+   while(numDigits > 0 && lineLength < MAX_STR_LEN - 1)
+   {
+      numDigits--;
+      line[ lineLength ] = digits[ numDigits ];
+      lineLength++;
    }
 
-  //assume not at end of list
-  localPtr->nextNode = addToOutputList(localPtr->nextNode, newLine, configPtr);
-  return localPtr;
-   
+   line[ lineLength ] = NULL_CHAR;
+
+   return lineLength;
 }
 
+/*
+Function Name: appendToLine
+Algorithm: copies source to end of line, starting at known line length
+Precondition: line holds lineLength characters
+Postcondition: source and null character are added,
+               new line length is returned
+Exceptions: stops at MAX_STR_LEN like concatenateString
+Notes: unlike concatenateString, never rescans the line to find its end
+*/
+int appendToLine( char *line, int lineLength, char *source )
+{
+   while(*source != NULL_CHAR && lineLength < MAX_STR_LEN - 1)
+   {
+      line[ lineLength ] = *source;
+      lineLength++;
+      source++;
+   }
+
+   line[ lineLength ] = NULL_CHAR;
+
+   return lineLength;
+}
 
 /*
 Function Name: clearOutputList
-Algorithm: recursively iterates through output linked list,
-           returns memory to OS from the bottom of the list upward
+Algorithm: iterates through output linked list,
+           returns memory to OS from the top of the list downward
 Precondition: linked list, with or without data
 Postcondition: all node memory, if any, is returned to OS,
                return pointer (head) is set to nulll
 Exceptions: none
-Notes: none
+Notes: no recursion, so list length does not bound stack depth
 */
 outputNode *clearOutputList( outputNode *localPtr )
    { 
-      //check for local pointer not set to null(list not empty)
-      if( localPtr != NULL )
+      outputNode *nextPtr;
+
+      //loop until local pointer is set to null (list empty)
+      while( localPtr != NULL )
       {      
-         //call recursive function with next pointer
-          clearOutputList( localPtr->nextNode );      
-         //after recursive call, release memory to OS
+         //keep next pointer, then release memory to OS
             //function: free
+         nextPtr = localPtr->nextNode;
          free( localPtr );   
-         //set local pointer to null
-         localPtr = NULL;
+         localPtr = nextPtr;
       }   
       //return null to calling function
       return NULL;
@@ -69,13 +169,67 @@ void writeToFile(ConfigDataType *configPtr, outputNode *outputHead)
 {
    FILE * filePtr = fopen(configPtr->logToFileName, "w");
    outputNode *localPtr = outputHead;
+
+   //lines already end in newlines, so each node is written whole
    while(localPtr != NULL)
    {
-      fprintf(filePtr, localPtr->currentLine);
-      fprintf(filePtr, "\n");
+      fwrite(localPtr->lines, sizeof(char), localPtr->used, filePtr);
       localPtr = localPtr->nextNode;
    }
 
    fclose(filePtr);
 }
   
+
+/*
+Function Name: setLogHeader
+Algorithm: builds " Process: N, " header for given PCB once
+Precondition: PCB has its process ID set
+Postcondition: header and its length are stored in the PCB
+Exceptions: none
+Notes: reused for every log line of the process
+*/
+void setLogHeader( ProcessControlBlock *pcb )
+{
+   int length = appendToLine(pcb->logHeader, 0, " Process: ");
+
+   length = appendIntToLine(pcb->logHeader, length, pcb->processID);
+   pcb->logHeaderLength = appendToLine(pcb->logHeader, length, ", ");
+}
+
+/*
+Function Name: startLogLine
+Algorithm: writes time followed by ", " to start a log line
+Precondition: line has room for MAX_STR_LEN characters
+Postcondition: line holds time prefix, its length is returned
+Exceptions: none
+Notes: none
+*/
+int startLogLine( char *line, SimTime time )
+{
+   int length = timeToString(time, line);
+
+   line[ length ] = COMMA;
+   line[ length + 1 ] = SPACE;
+   line[ length + 2 ] = NULL_CHAR;
+
+   return length + 2;
+}
+
+/*
+Function Name: startProcessLogLine
+Algorithm: writes time and cached process header to start a log line
+Precondition: line has room for MAX_STR_LEN characters,
+              PCB header set by setLogHeader
+Postcondition: line holds time and process prefix, its length is returned
+Exceptions: none
+Notes: copies header by its stored length, no string scans
+*/
+int startProcessLogLine( char *line, SimTime time, ProcessControlBlock *pcb )
+{
+   int length = startLogLine(line, time);
+
+   memcpy(&line[ length ], pcb->logHeader, pcb->logHeaderLength + 1);
+
+   return length + pcb->logHeaderLength;
+}
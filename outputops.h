@@ -8,7 +8,12 @@
 
 //function headers
 outputNode *addToOutputList( outputNode *localPtr, char *newLine, ConfigDataType *configPtr );
+int appendIntToLine( char *line, int lineLength, int value );
+int appendToLine( char *line, int lineLength, char *source );
 outputNode *clearOutputList( outputNode *localPtr );
+void setLogHeader( ProcessControlBlock *pcb );
+int startLogLine( char *line, SimTime time );
+int startProcessLogLine( char *line, SimTime time, ProcessControlBlock *pcb );
 void writeToFile(ConfigDataType *configPtr, outputNode *outputHead);
 
 
@@ -0,0 +1,633 @@
+#include "pageops.h"
+
+//global constants
+const int NO_FRAME = -1;
+const int DEFAULT_PAGE_SIZE = 4;
+
+//replacement policy names, in PageReplaceCodes order
+static const char *PAGE_REPLACE_NAMES[] = { "FIFO", "LRU", "CLOCK", "WS" };
+static const int NUM_PAGE_REPLACE_CODES
+            = sizeof(PAGE_REPLACE_NAMES) / sizeof(PAGE_REPLACE_NAMES[ 0 ]);
+
+//working set window, in references per frame
+static const int WORKING_SET_WINDOW_FRAMES = 2;
+
+/*
+Function Name: comparePageNumbers
+Algorithm: orders page entries by page number
+Precondition: given two page entries
+Postcondition: returns negative, zero, or positive as for qsort
+Exceptions: none
+Notes: local to page operations
+*/
+static int comparePageNumbers( const void *oneEntry, const void *otherEntry )
+{
+   return ((const PageEntry *) oneEntry)->pageNumber
+                         - ((const PageEntry *) otherEntry)->pageNumber;
+}
+
+/*
+Function Name: getPageRange
+Algorithm: divides first and last address of range by page size
+Precondition: given address, length, and page size
+Postcondition: first and last page of range are returned as parameters
+Exceptions: range of no length still touches page of its address
+Notes: local to page operations
+*/
+static void getPageRange( int address, int length, int pageSize,
+                                          int *firstPage, int *lastPage )
+{
+   *firstPage = address / pageSize;
+   *lastPage = *firstPage;
+   if(length > 0)
+   {
+      *lastPage = (address + length - 1) / pageSize;
+   }
+}
+
+/*
+Function Name: findPageEntry
+Algorithm: binary searches process's page table for page
+Precondition: given process and page number
+Postcondition: returns entry of page, or NULL if process has none
+Exceptions: none
+Notes: local to page operations; O(log p) for p pages
+*/
+static PageEntry *findPageEntry( ProcessControlBlock *pcb, int pageNumber )
+{
+   int low = 0;
+   int high = pcb->numPages - 1;
+   int middle;
+
+   while(low <= high)
+   {
+      middle = (low + high) / 2;
+      if(pcb->pageTable[ middle ].pageNumber == pageNumber)
+      {
+         return &pcb->pageTable[ middle ];
+      }
+      if(pcb->pageTable[ middle ].pageNumber < pageNumber)
+      {
+         low = middle + 1;
+      }
+      else
+      {
+         high = middle - 1;
+      }
+   }
+   return NULL;
+}
+
+/*
+Function Name: findTlbEntry
+Algorithm: compares page against every cached translation of process
+Precondition: given paged memory, process, and page number
+Postcondition: returns cached entry of page, or NULL on a miss
+Exceptions: none
+Notes: local to page operations; TLB is fully associative, so every
+       entry is looked at, as hardware would in parallel
+*/
+static TlbEntry *findTlbEntry( PagedMemory *memory, ProcessControlBlock *pcb,
+                                                           int pageNumber )
+{
+   int index;
+
+   for(index = 0; index < TLB_ENTRIES; index++)
+   {
+      if(memory->tlb[ index ].entry != NULL
+            && memory->tlb[ index ].ownerPid == pcb->processID
+            && memory->tlb[ index ].entry->pageNumber == pageNumber)
+      {
+         return &memory->tlb[ index ];
+      }
+   }
+   return NULL;
+}
+
+/*
+Function Name: cacheTranslation
+Algorithm: puts page entry in unused or least recently used TLB slot
+Precondition: given paged memory, process, and resident page entry
+Postcondition: translation is cached
+Exceptions: none
+Notes: local to page operations
+*/
+static void cacheTranslation( PagedMemory *memory, ProcessControlBlock *pcb,
+                                                         PageEntry *entry )
+{
+   int index;
+   int victim = 0;
+
+   for(index = 0; index < TLB_ENTRIES; index++)
+   {
+      if(memory->tlb[ index ].entry == NULL)
+      {
+         victim = index;
+         break;
+      }
+      if(memory->tlb[ index ].lastUse < memory->tlb[ victim ].lastUse)
+      {
+         victim = index;
+      }
+   }
+
+   memory->tlb[ victim ].entry = entry;
+   memory->tlb[ victim ].ownerPid = pcb->processID;
+   memory->tlb[ victim ].lastUse = memory->references;
+}
+
+/*
+Function Name: chooseVictimFrame
+Algorithm: FIFO and LRU take frame at top of heap; CLOCK sweeps hand,
+           clearing referenced flags, to first frame not referenced;
+           working set sweeps hand to first frame whose page has not
+           been used within window, or takes least recently used frame
+           seen if every page is in its working set
+Precondition: given paged memory with every frame in use
+Postcondition: returns index of frame to empty
+Exceptions: none
+Notes: local to page operations; FIFO and LRU are O(log f),
+       CLOCK and working set O(f) at worst for f frames
+*/
+static int chooseVictimFrame( PagedMemory *memory )
+{
+   PageFrame *frame;
+   int victim = NO_FRAME;
+   int oldest;
+   int step;
+
+   if(memory->victimQueue != NULL)
+   {
+      frame = (PageFrame *) popHeapItem(memory->victimQueue);
+      return frame - memory->frames;
+   }
+
+   if(memory->replaceCode == PAGE_REPLACE_CLOCK)
+   {
+      while(victim == NO_FRAME)
+      {
+         frame = &memory->frames[ memory->clockHand ];
+         if(frame->referenced == True)
+         {
+            frame->referenced = False;
+         }
+         else
+         {
+            victim = memory->clockHand;
+         }
+         memory->clockHand = (memory->clockHand + 1) % memory->numFrames;
+      }
+      return victim;
+   }
+
+   oldest = memory->clockHand;
+   for(step = 0; step < memory->numFrames && victim == NO_FRAME; step++)
+   {
+      frame = &memory->frames[ memory->clockHand ];
+      if(memory->references - frame->lastUse > memory->workingSetWindow)
+      {
+         victim = memory->clockHand;
+      }
+      else if(frame->lastUse < memory->frames[ oldest ].lastUse)
+      {
+         oldest = memory->clockHand;
+      }
+      memory->clockHand = (memory->clockHand + 1) % memory->numFrames;
+   }
+
+   if(victim == NO_FRAME)
+   {
+      victim = oldest;
+   }
+   return victim;
+}
+
+/*
+Function Name: evictFrame
+Algorithm: marks frame's page not resident and drops its translation
+Precondition: given paged memory and index of frame in use
+Postcondition: frame can take another page
+Exceptions: none
+Notes: local to page operations
+*/
+static void evictFrame( PagedMemory *memory, int frameIndex )
+{
+   PageFrame *frame = &memory->frames[ frameIndex ];
+   int index;
+
+   for(index = 0; index < TLB_ENTRIES; index++)
+   {
+      if(memory->tlb[ index ].entry == frame->entry)
+      {
+         memory->tlb[ index ].entry = NULL;
+      }
+   }
+
+   frame->entry->frameIndex = NO_FRAME;
+   frame->entry = NULL;
+   memory->evictions++;
+}
+
+/*
+Function Name: releaseFrame
+Algorithm: takes frame out of victim heap, empties it, and puts it back
+           on free frame stack
+Precondition: given paged memory and index of frame in use
+Postcondition: frame can take another page, its page is not told
+Exceptions: none
+Notes: local to page operations
+*/
+static void releaseFrame( PagedMemory *memory, int frameIndex )
+{
+   PageFrame *frame = &memory->frames[ frameIndex ];
+
+   if(memory->victimQueue != NULL)
+   {
+      removeHeapItem(memory->victimQueue, frame->heapIndex);
+   }
+   frame->entry = NULL;
+   memory->freeFrames[ memory->numFree ] = frameIndex;
+   memory->numFree++;
+}
+
+/*
+Function Name: loadPage
+Algorithm: takes free frame, or empties one the policy chooses, and
+           places page in it
+Precondition: given paged memory, process, and page entry not resident
+Postcondition: page is resident
+Exceptions: none
+Notes: local to page operations
+*/
+static void loadPage( PagedMemory *memory, ProcessControlBlock *pcb,
+                                                         PageEntry *entry )
+{
+   PageFrame *frame;
+   int frameIndex;
+
+   if(memory->numFree > 0)
+   {
+      memory->numFree--;
+      frameIndex = memory->freeFrames[ memory->numFree ];
+   }
+   else
+   {
+      frameIndex = chooseVictimFrame(memory);
+      evictFrame(memory, frameIndex);
+   }
+
+   frame = &memory->frames[ frameIndex ];
+   frame->entry = entry;
+   frame->ownerPid = pcb->processID;
+   frame->lastUse = memory->references;
+   frame->referenced = True;
+   if(memory->victimQueue != NULL)
+   {
+      insertHeapItem(memory->victimQueue, memory->references, frameIndex,
+                                                     frame, &frame->heapIndex);
+   }
+
+   entry->frameIndex = frameIndex;
+   memory->pageFaults++;
+}
+
+/*
+Function Name: clearPagedMemory
+Algorithm: releases frames, free frame stack, heap, and paged memory
+Precondition: given paged memory or NULL
+Postcondition: paged memory freed, returns NULL
+Exceptions: none
+Notes: page tables belong to their processes
+*/
+PagedMemory *clearPagedMemory( PagedMemory *memory )
+{
+   if(memory != NULL)
+   {
+      memory->victimQueue = clearMinHeap(memory->victimQueue);
+      free(memory->frames);
+      free(memory->freeFrames);
+      free(memory);
+   }
+   return NULL;
+}
+
+/*
+Function Name: createPageTable
+Algorithm: lists every page covered by process's mem allocate ops,
+           sorts them, and keeps each page once
+Precondition: given meta data pointer at process's app start, page size,
+              and place for number of pages
+Postcondition: returns page table with no page resident, or NULL if
+               process allocates nothing; number of pages is returned
+               as parameter
+Exceptions: none
+Notes: holds pages a process may use, not its whole address space, so
+       table size follows what the program allocates
+*/
+PageEntry *createPageTable( OpCodeType *metaDataPointer, int pageSize,
+                                                            int *numPages )
+{
+   OpCodeType *opPtr;
+   PageEntry *pageTable;
+   int firstPage, lastPage, page;
+   int pageCount = 0;
+   int index;
+
+   //count pages of each allocation, pages shared by two are counted twice
+   for(opPtr = metaDataPointer; opPtr != NULL
+            && !(compareString(opPtr->command, "app") == STR_EQ
+                    && compareString(opPtr->strArg1, "end") == STR_EQ);
+                                                  opPtr = opPtr->nextNode)
+   {
+      if(compareString(opPtr->command, "mem") == STR_EQ
+            && compareString(opPtr->strArg1, "allocate") == STR_EQ)
+      {
+         getPageRange(opPtr->intArg2, opPtr->intArg3, pageSize,
+                                                  &firstPage, &lastPage);
+         pageCount += lastPage - firstPage + 1;
+      }
+   }
+
+   *numPages = 0;
+   if(pageCount == 0)
+   {
+      return NULL;
+   }
+
+   //list them all
+   pageTable = (PageEntry *) malloc(sizeof(PageEntry) * pageCount);
+   for(opPtr = metaDataPointer; opPtr != NULL
+            && !(compareString(opPtr->command, "app") == STR_EQ
+                    && compareString(opPtr->strArg1, "end") == STR_EQ);
+                                                  opPtr = opPtr->nextNode)
+   {
+      if(compareString(opPtr->command, "mem") == STR_EQ
+            && compareString(opPtr->strArg1, "allocate") == STR_EQ)
+      {
+         getPageRange(opPtr->intArg2, opPtr->intArg3, pageSize,
+                                                  &firstPage, &lastPage);
+         for(page = firstPage; page <= lastPage; page++)
+         {
+            pageTable[ *numPages ].pageNumber = page;
+            (*numPages)++;
+         }
+      }
+   }
+
+   //sort, then keep first of each page
+   qsort(pageTable, pageCount, sizeof(PageEntry), comparePageNumbers);
+   *numPages = 0;
+   for(index = 0; index < pageCount; index++)
+   {
+      if(*numPages == 0
+            || pageTable[ *numPages - 1 ].pageNumber
+                                         != pageTable[ index ].pageNumber)
+      {
+         pageTable[ *numPages ].pageNumber = pageTable[ index ].pageNumber;
+         pageTable[ *numPages ].frameIndex = NO_FRAME;
+         (*numPages)++;
+      }
+   }
+
+   return (PageEntry *) realloc(pageTable, sizeof(PageEntry) * *numPages);
+}
+
+/*
+Function Name: createPagedMemory
+Algorithm: allocates frames, all free, empty TLB, and heap if policy
+           needs one
+Precondition: given config data with paging settings
+Postcondition: returns paged memory with no page resident
+Exceptions: frame count of zero means as many frames as fit in
+            available memory
+Notes: none
+*/
+PagedMemory *createPagedMemory( ConfigDataType *configPtr )
+{
+   PagedMemory *memory = (PagedMemory *) malloc(sizeof(PagedMemory));
+   int index;
+
+   //frame count not given, physical memory is divided into frames
+   memory->numFrames = configPtr->pageFrames;
+   if(memory->numFrames < 1)
+   {
+      memory->numFrames = configPtr->memAvailable / configPtr->pageSize;
+      if(memory->numFrames < 1)
+      {
+         memory->numFrames = 1;
+      }
+   }
+   memory->pageSize = configPtr->pageSize;
+   memory->replaceCode = configPtr->pageReplaceCode;
+   memory->frames =
+               (PageFrame *) malloc(sizeof(PageFrame) * memory->numFrames);
+   memory->freeFrames = (int *) malloc(sizeof(int) * memory->numFrames);
+
+   //frame zero comes off free stack first
+   for(index = 0; index < memory->numFrames; index++)
+   {
+      memory->frames[ index ].entry = NULL;
+      memory->frames[ index ].heapIndex = NOT_IN_HEAP;
+      memory->freeFrames[ index ] = memory->numFrames - 1 - index;
+   }
+   memory->numFree = memory->numFrames;
+
+   memory->victimQueue = NULL;
+   if(memory->replaceCode == PAGE_REPLACE_FIFO
+                           || memory->replaceCode == PAGE_REPLACE_LRU)
+   {
+      memory->victimQueue = createMinHeap(memory->numFrames);
+   }
+   memory->clockHand = 0;
+   memory->workingSetWindow =
+                    (long) memory->numFrames * WORKING_SET_WINDOW_FRAMES;
+
+   for(index = 0; index < TLB_ENTRIES; index++)
+   {
+      memory->tlb[ index ].entry = NULL;
+   }
+
+   memory->references = 0;
+   memory->tlbHits = 0;
+   memory->tlbMisses = 0;
+   memory->pageFaults = 0;
+   memory->evictions = 0;
+
+   return memory;
+}
+
+/*
+Function Name: findPageReplaceCode
+Algorithm: compares lower case name against each policy name
+Precondition: given policy name
+Postcondition: returns matching PageReplaceCodes value, or -1 if none
+Exceptions: none
+Notes: name is not case sensitive
+*/
+int findPageReplaceCode( char *name )
+{
+   char tempStr[ MAX_STR_LEN ];
+   char policyStr[ MAX_STR_LEN ];
+   int index;
+
+   if(getStringLength(name) >= MAX_STR_LEN)
+   {
+      return -1;
+   }
+   setStrToLowerCase(tempStr, name);
+
+   for(index = 0; index < NUM_PAGE_REPLACE_CODES; index++)
+   {
+      setStrToLowerCase(policyStr, (char *) PAGE_REPLACE_NAMES[ index ]);
+      if(compareString(tempStr, policyStr) == STR_EQ)
+      {
+         return index;
+      }
+   }
+   return -1;
+}
+
+/*
+Function Name: getPageReplaceName
+Algorithm: copies display name of policy
+Precondition: given PageReplaceCodes value and string to fill
+Postcondition: string holds policy name
+Exceptions: none
+Notes: none
+*/
+void getPageReplaceName( int replaceCode, char *outString )
+{
+   copyString(outString, (char *) PAGE_REPLACE_NAMES[ replaceCode ]);
+}
+
+/*
+Function Name: releaseProcessPages
+Algorithm: frees frame of each resident page of process, drops its
+           cached translations, then releases its page table
+Precondition: given paged memory and exiting process
+Postcondition: process holds no frames and no page table
+Exceptions: none
+Notes: O(p) for p pages of process, plus heap removals
+*/
+void releaseProcessPages( PagedMemory *memory, ProcessControlBlock *pcb )
+{
+   int index;
+
+   for(index = 0; index < pcb->numPages; index++)
+   {
+      if(pcb->pageTable[ index ].frameIndex != NO_FRAME)
+      {
+         releaseFrame(memory, pcb->pageTable[ index ].frameIndex);
+      }
+   }
+
+   for(index = 0; index < TLB_ENTRIES; index++)
+   {
+      if(memory->tlb[ index ].entry != NULL
+            && memory->tlb[ index ].ownerPid == pcb->processID)
+      {
+         memory->tlb[ index ].entry = NULL;
+      }
+   }
+
+   free(pcb->pageTable);
+   pcb->pageTable = NULL;
+   pcb->numPages = 0;
+}
+
+/*
+Function Name: releasePages
+Algorithm: frees frame of each resident page in range and drops its
+           cached translation
+Precondition: given paged memory, process, and first and last page of
+              range no live block of process still uses
+Postcondition: pages of range are not resident, page table keeps them so
+               a later allocation can load them again
+Exceptions: empty range, or page missing from page table, is skipped
+Notes: O(log p) per page of range, plus heap removals
+*/
+void releasePages( PagedMemory *memory, ProcessControlBlock *pcb,
+                                              int firstPage, int lastPage )
+{
+   PageEntry *entry;
+   int page;
+   int index;
+
+   for(page = firstPage; page <= lastPage; page++)
+   {
+      entry = findPageEntry(pcb, page);
+      if(entry == NULL || entry->frameIndex == NO_FRAME)
+      {
+         continue;
+      }
+
+      for(index = 0; index < TLB_ENTRIES; index++)
+      {
+         if(memory->tlb[ index ].entry == entry)
+         {
+            memory->tlb[ index ].entry = NULL;
+         }
+      }
+      releaseFrame(memory, entry->frameIndex);
+      entry->frameIndex = NO_FRAME;
+   }
+}
+
+/*
+Function Name: touchPages
+Algorithm: for each page of range, looks in TLB, then page table on a
+           miss, loading page on a fault; marks page's frame used
+Precondition: given paged memory, process, and address range inside
+              memory process has allocated
+Postcondition: every page of range is resident, returns pages loaded
+Exceptions: page missing from page table is skipped
+Notes: O(log p) per page on a TLB miss, plus replacement
+*/
+int touchPages( PagedMemory *memory, ProcessControlBlock *pcb,
+                                                     int address, int length )
+{
+   TlbEntry *tlbEntry;
+   PageEntry *entry;
+   PageFrame *frame;
+   int firstPage, lastPage, page;
+   long faultsBefore = memory->pageFaults;
+
+   getPageRange(address, length, memory->pageSize, &firstPage, &lastPage);
+   for(page = firstPage; page <= lastPage; page++)
+   {
+      memory->references++;
+
+      tlbEntry = findTlbEntry(memory, pcb, page);
+      if(tlbEntry != NULL)
+      {
+         memory->tlbHits++;
+         tlbEntry->lastUse = memory->references;
+         entry = tlbEntry->entry;
+      }
+      else
+      {
+         memory->tlbMisses++;
+         entry = findPageEntry(pcb, page);
+         if(entry == NULL)
+         {
+            continue;
+         }
+         if(entry->frameIndex == NO_FRAME)
+         {
+            loadPage(memory, pcb, entry);
+         }
+         cacheTranslation(memory, pcb, entry);
+      }
+
+      frame = &memory->frames[ entry->frameIndex ];
+      frame->lastUse = memory->references;
+      frame->referenced = True;
+      if(memory->replaceCode == PAGE_REPLACE_LRU)
+      {
+         updateHeapKey(memory->victimQueue, frame->heapIndex,
+                                                      memory->references);
+      }
+   }
+
+   return (int) (memory->pageFaults - faultsBefore);
+}
@@ -0,0 +1,72 @@
+//pre-compiler directive
+#ifndef PAGEOPS_H
+#define PAGEOPS_H
+
+//header files
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "heapops.h"
+#include <stdlib.h>
+
+//constants
+#define TLB_ENTRIES 16
+
+extern const int NO_FRAME;
+extern const int DEFAULT_PAGE_SIZE;
+
+//types
+typedef enum { PAGE_REPLACE_FIFO,
+               PAGE_REPLACE_LRU,
+               PAGE_REPLACE_CLOCK,
+               PAGE_REPLACE_WS } PageReplaceCodes;
+
+typedef struct PageFrame
+   {
+      PageEntry *entry;         //page held, NULL if frame is free
+      int ownerPid;             //process page belongs to
+      long lastUse;             //reference count when page was last used
+      Boolean referenced;       //used since clock hand last passed
+      int heapIndex;            //position in FIFO or LRU heap
+   } PageFrame;
+
+typedef struct TlbEntry
+   {
+      PageEntry *entry;         //cached translation, NULL if unused
+      int ownerPid;             //process translation belongs to
+      long lastUse;             //reference count when entry was last used
+   } TlbEntry;
+
+typedef struct PagedMemory
+   {
+      PageFrame *frames;
+      int numFrames;
+      int *freeFrames;          //stack of free frame indices
+      int numFree;
+      int replaceCode;          //PageReplaceCodes value
+      int pageSize;             //KB per page
+      int clockHand;            //next frame CLOCK and working set look at
+      long workingSetWindow;    //references a page stays in working set
+      MinHeap *victimQueue;     //frames by load order for FIFO, by last
+                                // use for LRU, NULL otherwise
+      TlbEntry tlb[ TLB_ENTRIES ];
+      long references;          //pages referenced so far
+      long tlbHits;
+      long tlbMisses;
+      long pageFaults;          //pages loaded
+      long evictions;           //pages removed to make room
+   } PagedMemory;
+
+//function headers
+PagedMemory *clearPagedMemory( PagedMemory *memory );
+PageEntry *createPageTable( OpCodeType *metaDataPointer, int pageSize,
+                                                           int *numPages );
+PagedMemory *createPagedMemory( ConfigDataType *configPtr );
+int findPageReplaceCode( char *name );
+void getPageReplaceName( int replaceCode, char *outString );
+void releasePages( PagedMemory *memory, ProcessControlBlock *pcb,
+                                              int firstPage, int lastPage );
+void releaseProcessPages( PagedMemory *memory, ProcessControlBlock *pcb );
+int touchPages( PagedMemory *memory, ProcessControlBlock *pcb,
+                                                    int address, int length );
+
+#endif //PAGEOPS_H
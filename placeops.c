@@ -0,0 +1,851 @@
+#include "placeops.h"
+#include "simtimer.h"
+
+//global constants
+const int NO_PLACEMENT = -1;
+
+//placement allocator names, in PlacementCodes order after PLACE_NONE
+static const char *PLACEMENT_NAMES[]
+                         = { "FIRST", "NEXT", "BEST", "BUDDY", "SLAB" };
+static const int NUM_PLACEMENT_CODES
+                 = sizeof(PLACEMENT_NAMES) / sizeof(PLACEMENT_NAMES[ 0 ]);
+
+//KB carved from free list for each slab
+static const int SLAB_SIZE = 64;
+
+/*
+Function Name: getBlockOrder
+Algorithm: doubles block size from one KB until it holds size
+Precondition: given size of at least one KB
+Postcondition: returns smallest power of two, as exponent, not below size
+Exceptions: none
+Notes: local to placement operations
+*/
+static int getBlockOrder( int size )
+{
+   int order = 0;
+
+   while((1 << order) < size)
+   {
+      order++;
+   }
+   return order;
+}
+
+/*
+Function Name: getSlabClass
+Algorithm: finds size class of smallest power of two holding size
+Precondition: given size of at least one KB
+Postcondition: returns size class index, or -1 if size is larger than
+               largest class
+Exceptions: none
+Notes: local to placement operations; class i holds objects of 2^i KB
+*/
+static int getSlabClass( int size )
+{
+   int classIndex = getBlockOrder(size);
+
+   if(classIndex >= SLAB_CLASSES)
+   {
+      return -1;
+   }
+   return classIndex;
+}
+
+/*
+Function Name: insertFreeBlock
+Algorithm: puts block in address tree, valued by size, and size tree
+Precondition: given free list and block not in it
+Postcondition: block is free
+Exceptions: none
+Notes: local to placement operations; O(log n)
+*/
+static void insertFreeBlock( FreeList *freeList, FreeBlock *block )
+{
+   insertTreeValue(freeList->byAddress, block->base, 0, block, block->size);
+   insertTreeItem(freeList->bySize, block->size, block->base, block);
+   freeList->freeSize += block->size;
+}
+
+/*
+Function Name: removeFreeBlock
+Algorithm: takes block out of address tree and size tree
+Precondition: given free list and block in it
+Postcondition: block is no longer free, caller owns it
+Exceptions: none
+Notes: local to placement operations; O(log n)
+*/
+static void removeFreeBlock( FreeList *freeList, FreeBlock *block )
+{
+   removeTreeItem(freeList->byAddress, block->base, 0);
+   removeTreeItem(freeList->bySize, block->size, block->base);
+   freeList->freeSize -= block->size;
+}
+
+/*
+Function Name: clearFreeList
+Algorithm: releases every free block, both trees, then list
+Precondition: given free list or NULL
+Postcondition: free list memory freed, returns NULL
+Exceptions: none
+Notes: local to placement operations
+*/
+static FreeList *clearFreeList( FreeList *freeList )
+{
+   if(freeList != NULL)
+   {
+      while(treeIsEmpty(freeList->bySize) == False)
+      {
+         free(popTreeMin(freeList->bySize));
+      }
+      freeList->bySize = clearOrderedTree(freeList->bySize);
+      freeList->byAddress = clearOrderedTree(freeList->byAddress);
+      free(freeList);
+   }
+   return NULL;
+}
+
+/*
+Function Name: createFreeList
+Algorithm: allocates free list holding one free block
+Precondition: given base and size in KB of free memory, and fit to use
+Postcondition: returns free list with only that memory free
+Exceptions: no free block if size is zero
+Notes: local to placement operations
+*/
+static FreeList *createFreeList( int base, int size, int fitCode )
+{
+   FreeList *freeList = (FreeList *) malloc(sizeof(FreeList));
+   FreeBlock *block;
+
+   freeList->byAddress = createOrderedTree();
+   freeList->bySize = createOrderedTree();
+   freeList->fitCode = fitCode;
+   freeList->rover = 0;
+   freeList->freeSize = 0;
+
+   if(size > 0)
+   {
+      block = (FreeBlock *) malloc(sizeof(FreeBlock));
+      block->base = base;
+      block->size = size;
+      insertFreeBlock(freeList, block);
+   }
+
+   return freeList;
+}
+
+/*
+Function Name: takeFromFreeList
+Algorithm: finds block by fit, first fit lowest base that holds size,
+           next fit first that holds size from where last one ended,
+           wrapping around, best fit smallest that holds size; gives
+           front of block and keeps rest free
+Precondition: given free list and size of at least one KB
+Postcondition: returns base of block taken, or NO_PLACEMENT if no free
+               block holds size
+Exceptions: none
+Notes: local to placement operations; O(log n) for n free blocks
+*/
+static int takeFromFreeList( FreeList *freeList, int size )
+{
+   FreeBlock *block;
+   int base;
+
+   if(freeList->fitCode == PLACE_BEST_FIT)
+   {
+      block = (FreeBlock *) findTreeCeiling(freeList->bySize, size);
+   }
+   else if(freeList->fitCode == PLACE_NEXT_FIT)
+   {
+      block = (FreeBlock *) findTreeFirstFit(freeList->byAddress,
+                                                    freeList->rover, size);
+      if(block == NULL)
+      {
+         block = (FreeBlock *) findTreeFirstFit(freeList->byAddress, 0, size);
+      }
+   }
+   else
+   {
+      block = (FreeBlock *) findTreeFirstFit(freeList->byAddress, 0, size);
+   }
+
+   if(block == NULL)
+   {
+      return NO_PLACEMENT;
+   }
+
+   removeFreeBlock(freeList, block);
+   base = block->base;
+   if(block->size > size)
+   {
+      block->base += size;
+      block->size -= size;
+      insertFreeBlock(freeList, block);
+   }
+   else
+   {
+      free(block);
+   }
+
+   freeList->rover = base + size;
+   return base;
+}
+
+/*
+Function Name: giveToFreeList
+Algorithm: merges block with free blocks right before and after it,
+           then frees result
+Precondition: given free list and block taken from it
+Postcondition: block is free, no two free blocks touch
+Exceptions: none
+Notes: local to placement operations; O(log n)
+*/
+static void giveToFreeList( FreeList *freeList, int base, int size )
+{
+   FreeBlock *block = (FreeBlock *) findTreeFloor(freeList->byAddress, base);
+   FreeBlock *nextBlock;
+
+   //merge with block ending where this one starts
+   if(block != NULL && block->base + block->size == base)
+   {
+      removeFreeBlock(freeList, block);
+      block->size += size;
+   }
+   else
+   {
+      block = (FreeBlock *) malloc(sizeof(FreeBlock));
+      block->base = base;
+      block->size = size;
+   }
+
+   //merge with block starting where this one ends
+   nextBlock = (FreeBlock *) findTreeFloor(freeList->byAddress,
+                                                   block->base + block->size);
+   if(nextBlock != NULL && nextBlock->base == block->base + block->size)
+   {
+      removeFreeBlock(freeList, nextBlock);
+      block->size += nextBlock->size;
+      free(nextBlock);
+   }
+
+   insertFreeBlock(freeList, block);
+}
+
+/*
+Function Name: insertBuddyBlock
+Algorithm: puts block in list of its order
+Precondition: given placement, base, and order of block not free
+Postcondition: block is free
+Exceptions: none
+Notes: local to placement operations; O(log n)
+*/
+static void insertBuddyBlock( Placement *placement, int base, int order )
+{
+   FreeBlock *block = (FreeBlock *) malloc(sizeof(FreeBlock));
+
+   block->base = base;
+   block->size = 1 << order;
+   insertTreeItem(placement->buddyLists[ order ], base, 0, block);
+   placement->buddyFree += block->size;
+}
+
+/*
+Function Name: takeBuddyBlock
+Algorithm: takes lowest block of smallest order with a free block that
+           holds size, splitting it in halves and freeing upper half
+           until it is of size's order
+Precondition: given placement and size of at least one KB
+Postcondition: returns base of block taken, or NO_PLACEMENT if none holds
+               size
+Exceptions: none
+Notes: local to placement operations; O(log n) per order looked at
+*/
+static int takeBuddyBlock( Placement *placement, int size )
+{
+   int wantOrder = getBlockOrder(size);
+   int order = wantOrder;
+   FreeBlock *block;
+   int base;
+
+   while(order < BUDDY_ORDERS
+                      && treeIsEmpty(placement->buddyLists[ order ]) == True)
+   {
+      order++;
+   }
+   if(order >= BUDDY_ORDERS)
+   {
+      return NO_PLACEMENT;
+   }
+
+   block = (FreeBlock *) popTreeMin(placement->buddyLists[ order ]);
+   base = block->base;
+   placement->buddyFree -= block->size;
+   free(block);
+
+   while(order > wantOrder)
+   {
+      order--;
+      insertBuddyBlock(placement, base + (1 << order), order);
+   }
+   return base;
+}
+
+/*
+Function Name: giveBuddyBlock
+Algorithm: while block's buddy, at base with bit of block's order
+           flipped, is free and of same order, merges the two; frees
+           merged block
+Precondition: given placement and block taken from it, with size asked
+              for
+Postcondition: block is free
+Exceptions: none
+Notes: local to placement operations; memory is split into blocks by
+       the binary digits of its size, largest first, so a block's buddy
+       is never outside the block it came from; O(log n) per order
+*/
+static void giveBuddyBlock( Placement *placement, int base, int size )
+{
+   int order = getBlockOrder(size);
+   FreeBlock *buddy;
+
+   while(order < BUDDY_ORDERS - 1)
+   {
+      buddy = (FreeBlock *) removeTreeItem(placement->buddyLists[ order ],
+                                                   base ^ (1 << order), 0);
+      if(buddy == NULL)
+      {
+         break;
+      }
+      placement->buddyFree -= buddy->size;
+      if(buddy->base < base)
+      {
+         base = buddy->base;
+      }
+      free(buddy);
+      order++;
+   }
+   insertBuddyBlock(placement, base, order);
+}
+
+/*
+Function Name: unlinkPartialSlab
+Algorithm: takes slab out of its class's list of slabs with free objects
+Precondition: given placement and slab in that list
+Postcondition: slab is in no list
+Exceptions: none
+Notes: local to placement operations
+*/
+static void unlinkPartialSlab( Placement *placement, Slab *slab )
+{
+   if(slab->prevPartial != NULL)
+   {
+      slab->prevPartial->nextPartial = slab->nextPartial;
+   }
+   else
+   {
+      placement->partialSlabs[ slab->classIndex ] = slab->nextPartial;
+   }
+   if(slab->nextPartial != NULL)
+   {
+      slab->nextPartial->prevPartial = slab->prevPartial;
+   }
+   slab->prevPartial = NULL;
+   slab->nextPartial = NULL;
+}
+
+/*
+Function Name: linkPartialSlab
+Algorithm: puts slab at front of its class's list of slabs with free
+           objects
+Precondition: given placement and slab in no list
+Postcondition: slab is in list
+Exceptions: none
+Notes: local to placement operations
+*/
+static void linkPartialSlab( Placement *placement, Slab *slab )
+{
+   slab->prevPartial = NULL;
+   slab->nextPartial = placement->partialSlabs[ slab->classIndex ];
+   if(slab->nextPartial != NULL)
+   {
+      slab->nextPartial->prevPartial = slab;
+   }
+   placement->partialSlabs[ slab->classIndex ] = slab;
+}
+
+/*
+Function Name: clearSlab
+Algorithm: releases free object stack, then slab
+Precondition: given slab
+Postcondition: slab memory freed, returns NULL
+Exceptions: none
+Notes: local to placement operations
+*/
+static Slab *clearSlab( Slab *slab )
+{
+   free(slab->freeObjects);
+   free(slab);
+   return NULL;
+}
+
+/*
+Function Name: takeSlabObject
+Algorithm: takes free object from a slab of size's class, carving new
+           slab from free list when class has none with a free object
+Precondition: given placement and size class
+Postcondition: returns base of object taken, or NO_PLACEMENT if no slab
+               could be carved
+Exceptions: none
+Notes: local to placement operations; O(1) unless a slab is carved
+*/
+static int takeSlabObject( Placement *placement, int classIndex )
+{
+   Slab *slab = placement->partialSlabs[ classIndex ];
+   int slabBase;
+   int index;
+
+   if(slab == NULL)
+   {
+      slabBase = takeFromFreeList(placement->freeList, SLAB_SIZE);
+      if(slabBase == NO_PLACEMENT)
+      {
+         return NO_PLACEMENT;
+      }
+
+      //object zero comes off free stack first
+      slab = (Slab *) malloc(sizeof(Slab));
+      slab->base = slabBase;
+      slab->classIndex = classIndex;
+      slab->objectSize = 1 << classIndex;
+      slab->numObjects = SLAB_SIZE / slab->objectSize;
+      slab->freeObjects = (int *) malloc(sizeof(int) * slab->numObjects);
+      for(index = 0; index < slab->numObjects; index++)
+      {
+         slab->freeObjects[ index ] = slab->numObjects - 1 - index;
+      }
+      slab->numFree = slab->numObjects;
+      insertTreeItem(placement->slabIndex, slabBase, 0, slab);
+      linkPartialSlab(placement, slab);
+   }
+
+   slab->numFree--;
+   if(slab->numFree == 0)
+   {
+      unlinkPartialSlab(placement, slab);
+   }
+   return slab->base
+               + slab->freeObjects[ slab->numFree ] * slab->objectSize;
+}
+
+/*
+Function Name: giveSlabObject
+Algorithm: finds slab holding object, frees object, and gives slab back
+           to free list once all its objects are free
+Precondition: given placement and base of object taken from it
+Postcondition: object is free
+Exceptions: none
+Notes: local to placement operations; O(log s) for s slabs
+*/
+static void giveSlabObject( Placement *placement, int base )
+{
+   Slab *slab = (Slab *) findTreeFloor(placement->slabIndex, base);
+
+   slab->freeObjects[ slab->numFree ] = (base - slab->base) / slab->objectSize;
+   slab->numFree++;
+   if(slab->numFree == 1)
+   {
+      linkPartialSlab(placement, slab);
+   }
+
+   if(slab->numFree == slab->numObjects)
+   {
+      unlinkPartialSlab(placement, slab);
+      removeTreeItem(placement->slabIndex, slab->base, 0);
+      giveToFreeList(placement->freeList, slab->base, SLAB_SIZE);
+      slab = clearSlab(slab);
+   }
+}
+
+/*
+Function Name: compareLiveBases
+Algorithm: orders live blocks by where they are placed
+Precondition: given two live blocks
+Postcondition: returns negative, zero, or positive as for qsort
+Exceptions: none
+Notes: local to placement operations
+*/
+static int compareLiveBases( const void *oneBlock, const void *otherBlock )
+{
+   return ((const LiveBlock *) oneBlock)->block->placedBase
+                         - ((const LiveBlock *) otherBlock)->block->placedBase;
+}
+
+/*
+Function Name: clearPlacement
+Algorithm: releases every slab, free block, and tree, then placement
+Precondition: given placement or NULL
+Postcondition: placement memory freed, returns NULL
+Exceptions: none
+Notes: none
+*/
+Placement *clearPlacement( Placement *placement )
+{
+   int order;
+
+   if(placement != NULL)
+   {
+      if(placement->slabIndex != NULL)
+      {
+         while(treeIsEmpty(placement->slabIndex) == False)
+         {
+            clearSlab((Slab *) popTreeMin(placement->slabIndex));
+         }
+         placement->slabIndex = clearOrderedTree(placement->slabIndex);
+      }
+
+      for(order = 0; order < BUDDY_ORDERS; order++)
+      {
+         if(placement->buddyLists[ order ] != NULL)
+         {
+            while(treeIsEmpty(placement->buddyLists[ order ]) == False)
+            {
+               free(popTreeMin(placement->buddyLists[ order ]));
+            }
+            placement->buddyLists[ order ]
+                         = clearOrderedTree(placement->buddyLists[ order ]);
+         }
+      }
+
+      placement->freeList = clearFreeList(placement->freeList);
+      free(placement);
+   }
+   return NULL;
+}
+
+/*
+Function Name: compactPlacement
+Algorithm: sorts live blocks by base and slides each down against one
+           before it, then frees all memory above last one as one block
+Precondition: given placement of a fit allocator and every block placed
+              from it
+Postcondition: no free memory lies between live blocks, each live block
+               holds KB copied to move it; returns KB copied in all
+Exceptions: none
+Notes: O(n log n) for n live blocks
+*/
+int compactPlacement( Placement *placement, LiveBlock *liveBlocks,
+                                                          int numBlocks )
+{
+   FreeList *freeList = placement->freeList;
+   int memSize = freeList->freeSize;
+   int nextBase = 0;
+   int movedTotal = 0;
+   int size;
+   int index;
+
+   qsort(liveBlocks, numBlocks, sizeof(LiveBlock), compareLiveBases);
+   for(index = 0; index < numBlocks; index++)
+   {
+      size = liveBlocks[ index ].block->upperBound
+                                     - liveBlocks[ index ].block->lowerBound;
+      if(size < 1)
+      {
+         size = 1;
+      }
+      memSize += size;
+
+      liveBlocks[ index ].movedSize = 0;
+      if(liveBlocks[ index ].block->placedBase != nextBase)
+      {
+         liveBlocks[ index ].block->placedBase = nextBase;
+         liveBlocks[ index ].movedSize = size;
+         movedTotal += size;
+      }
+      nextBase += size;
+   }
+
+   //all free memory is now above live blocks
+   placement->freeList = clearFreeList(freeList);
+   placement->freeList = createFreeList(nextBase, memSize - nextBase,
+                                                      placement->placeCode);
+
+   placement->compactions++;
+   placement->compactedSize += movedTotal;
+   return movedTotal;
+}
+
+/*
+Function Name: createPlacement
+Algorithm: sets up free memory for allocator in config data; buddy
+           splits memory into blocks by binary digits of its size,
+           largest first, so every block is aligned to its own size
+Precondition: given config data with allocator set
+Postcondition: returns placement with all of memory free
+Exceptions: none
+Notes: slabs are carved from a best fit free list
+*/
+Placement *createPlacement( ConfigDataType *configPtr )
+{
+   Placement *placement = (Placement *) malloc(sizeof(Placement));
+   int memSize = configPtr->memAvailable;
+   int base = 0;
+   int order;
+   int index;
+
+   placement->placeCode = configPtr->placeCode;
+   placement->freeList = NULL;
+   placement->slabIndex = NULL;
+   placement->buddyFree = 0;
+   for(order = 0; order < BUDDY_ORDERS; order++)
+   {
+      placement->buddyLists[ order ] = NULL;
+   }
+   for(index = 0; index < SLAB_CLASSES; index++)
+   {
+      placement->partialSlabs[ index ] = NULL;
+   }
+
+   if(placement->placeCode == PLACE_BUDDY)
+   {
+      for(order = BUDDY_ORDERS - 1; order >= 0; order--)
+      {
+         placement->buddyLists[ order ] = createOrderedTree();
+         if((memSize & (1 << order)) != 0)
+         {
+            insertBuddyBlock(placement, base, order);
+            base += 1 << order;
+         }
+      }
+   }
+   else if(placement->placeCode == PLACE_SLAB)
+   {
+      placement->freeList = createFreeList(0, memSize, PLACE_BEST_FIT);
+      placement->slabIndex = createOrderedTree();
+   }
+   else
+   {
+      placement->freeList = createFreeList(0, memSize, placement->placeCode);
+   }
+
+   placement->requests = 0;
+   placement->failures = 0;
+   placement->requestedTotal = 0;
+   placement->grantedTotal = 0;
+   placement->fragmentationTotal = 0;
+   placement->peakFragmentation = 0;
+   placement->releases = 0;
+   placement->allocatorTime = 0;
+   placement->compactions = 0;
+   placement->compactedSize = 0;
+
+   return placement;
+}
+
+/*
+Function Name: findPlacementCode
+Algorithm: compares lower case name against each allocator name
+Precondition: given allocator name
+Postcondition: returns matching PlacementCodes value, or PLACE_NONE if
+               none
+Exceptions: none
+Notes: name is not case sensitive
+*/
+int findPlacementCode( char *name )
+{
+   char tempStr[ MAX_STR_LEN ];
+   char placeStr[ MAX_STR_LEN ];
+   int index;
+
+   if(getStringLength(name) >= MAX_STR_LEN)
+   {
+      return PLACE_NONE;
+   }
+   setStrToLowerCase(tempStr, name);
+
+   for(index = 0; index < NUM_PLACEMENT_CODES; index++)
+   {
+      setStrToLowerCase(placeStr, (char *) PLACEMENT_NAMES[ index ]);
+      if(compareString(tempStr, placeStr) == STR_EQ)
+      {
+         return PLACE_FIRST_FIT + index;
+      }
+   }
+   return PLACE_NONE;
+}
+
+/*
+Function Name: getPlacementFragmentation
+Algorithm: finds share of free memory outside largest free block
+Precondition: given placement
+Postcondition: returns external fragmentation in tenths of percent
+Exceptions: no free memory counts as none
+Notes: slabs count as used
+*/
+long getPlacementFragmentation( Placement *placement )
+{
+   long totalFree;
+   long largestFree = 0;
+   int order;
+
+   if(placement->placeCode == PLACE_BUDDY)
+   {
+      totalFree = placement->buddyFree;
+      for(order = BUDDY_ORDERS - 1; order >= 0 && largestFree == 0; order--)
+      {
+         if(treeIsEmpty(placement->buddyLists[ order ]) == False)
+         {
+            largestFree = 1L << order;
+         }
+      }
+   }
+   else
+   {
+      totalFree = placement->freeList->freeSize;
+      largestFree = peekTreeMaxValue(placement->freeList->byAddress);
+   }
+
+   if(totalFree == 0)
+   {
+      return 0;
+   }
+   return (totalFree - largestFree) * 1000 / totalFree;
+}
+
+/*
+Function Name: getPlacementName
+Algorithm: copies display name of allocator
+Precondition: given PlacementCodes value other than PLACE_NONE and
+              string to fill
+Postcondition: string holds allocator name
+Exceptions: none
+Notes: none
+*/
+void getPlacementName( int placeCode, char *outString )
+{
+   copyString(outString,
+                  (char *) PLACEMENT_NAMES[ placeCode - PLACE_FIRST_FIT ]);
+}
+
+/*
+Function Name: placeBlock
+Algorithm: takes block of size from allocator, timing it, and records
+           size given, failure, and fragmentation left
+Precondition: given placement and size asked for
+Postcondition: returns base of block placed, or NO_PLACEMENT if memory
+               could not hold it
+Exceptions: size below one KB is placed as one KB
+Notes: buddy rounds size up to a power of two, slab to its size class;
+       sizes above largest class go to slabs' free list as they are
+*/
+int placeBlock( Placement *placement, int size )
+{
+   SimTime startTime = getMonotonicTime();
+   long granted = size;
+   long fragmentation;
+   int classIndex = -1;
+   int base;
+
+   if(size < 1)
+   {
+      size = 1;
+      granted = 1;
+   }
+   if(placement->placeCode == PLACE_SLAB)
+   {
+      classIndex = getSlabClass(size);
+   }
+
+   if(placement->placeCode == PLACE_BUDDY)
+   {
+      base = takeBuddyBlock(placement, size);
+      granted = 1L << getBlockOrder(size);
+   }
+   else if(classIndex >= 0)
+   {
+      base = takeSlabObject(placement, classIndex);
+      granted = 1L << classIndex;
+   }
+   else
+   {
+      base = takeFromFreeList(placement->freeList, size);
+   }
+   placement->allocatorTime += getMonotonicTime() - startTime;
+
+   placement->requests++;
+   if(base == NO_PLACEMENT)
+   {
+      placement->failures++;
+   }
+   else
+   {
+      placement->requestedTotal += size;
+      placement->grantedTotal += granted;
+   }
+
+   fragmentation = getPlacementFragmentation(placement);
+   placement->fragmentationTotal += fragmentation;
+   if(fragmentation > placement->peakFragmentation)
+   {
+      placement->peakFragmentation = fragmentation;
+   }
+
+   return base;
+}
+
+/*
+Function Name: releaseBlock
+Algorithm: gives block back to allocator it came from, timing it
+Precondition: given placement, base of block placed, and size asked for
+              when it was placed
+Postcondition: block is free
+Exceptions: none
+Notes: size asked for decides which allocator and how much, as when
+       block was placed
+*/
+void releaseBlock( Placement *placement, int base, int size )
+{
+   SimTime startTime = getMonotonicTime();
+
+   if(size < 1)
+   {
+      size = 1;
+   }
+
+   if(placement->placeCode == PLACE_BUDDY)
+   {
+      giveBuddyBlock(placement, base, size);
+   }
+   else if(placement->placeCode == PLACE_SLAB && getSlabClass(size) >= 0)
+   {
+      giveSlabObject(placement, base);
+   }
+   else
+   {
+      giveToFreeList(placement->freeList, base, size);
+   }
+
+   placement->allocatorTime += getMonotonicTime() - startTime;
+   placement->releases++;
+}
+
+/*
+Function Name: releaseProcessPlacements
+Algorithm: releases where each of process's blocks was placed
+Precondition: given placement and exiting process
+Postcondition: memory process held can be placed again
+Exceptions: none
+Notes: process's block array is released with its memory
+*/
+void releaseProcessPlacements( Placement *placement,
+                                               ProcessControlBlock *pcb )
+{
+   int segment;
+
+   for(segment = 0; segment < pcb->numSegments; segment++)
+   {
+      releaseBlock(placement, pcb->allocdMem[ segment ].placedBase,
+                                 pcb->allocdMem[ segment ].upperBound
+                                       - pcb->allocdMem[ segment ].lowerBound);
+   }
+}
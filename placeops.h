@@ -0,0 +1,95 @@
+//pre-compiler directive
+#ifndef PLACEOPS_H
+#define PLACEOPS_H
+
+//header files
+#include "datatypes.h"
+#include "StringUtils.h"
+#include "treeops.h"
+#include <stdlib.h>
+
+//constants
+#define BUDDY_ORDERS 31
+#define SLAB_CLASSES 5
+
+extern const int NO_PLACEMENT;
+
+//types
+typedef enum { PLACE_NONE,
+               PLACE_FIRST_FIT,
+               PLACE_NEXT_FIT,
+               PLACE_BEST_FIT,
+               PLACE_BUDDY,
+               PLACE_SLAB } PlacementCodes;
+
+typedef struct FreeBlock
+   {
+      int base;                 //first KB of free block
+      int size;                 //KB in free block
+   } FreeBlock;
+
+typedef struct FreeList
+   {
+      OrderedTree *byAddress;   //free blocks by base, valued by size
+      OrderedTree *bySize;      //same blocks by size, then base
+      int fitCode;              //PlacementCodes value of fit used
+      int rover;                //base next fit starts looking from
+      long freeSize;            //KB in all free blocks
+   } FreeList;
+
+typedef struct Slab
+   {
+      int base;                 //first KB of slab
+      int objectSize;           //KB in each object
+      int numObjects;
+      int *freeObjects;         //stack of free object indices
+      int numFree;
+      int classIndex;           //size class slab belongs to
+      struct Slab *prevPartial; //slabs of class with a free object
+      struct Slab *nextPartial;
+   } Slab;
+
+typedef struct LiveBlock
+   {
+      memBlock *block;          //placed block of a process
+      ProcessControlBlock *owner; //process holding it
+      int movedSize;            //KB copied to move it, 0 if it stayed
+   } LiveBlock;
+
+typedef struct Placement
+   {
+      int placeCode;            //PlacementCodes value
+      FreeList *freeList;       //free blocks for fits, slabs come from it
+      OrderedTree *buddyLists[ BUDDY_ORDERS ]; //free blocks of each power
+                                // of two KB, by base
+      long buddyFree;           //KB in all free buddy blocks
+      Slab *partialSlabs[ SLAB_CLASSES ]; //slabs with a free object, by
+                                // size class
+      OrderedTree *slabIndex;   //every slab, by base
+      long requests;            //blocks asked for
+      long failures;            //requests no free memory could hold
+      long requestedTotal;      //KB asked for by placed requests
+      long grantedTotal;        //KB given to them after rounding up
+      long fragmentationTotal;  //tenths of percent of free memory outside
+                                // largest free block, summed per request
+      long peakFragmentation;   //most of it seen after any request
+      long releases;            //blocks given back
+      SimTime allocatorTime;    //ns spent placing and releasing blocks
+      long compactions;         //times live blocks were slid together
+      long compactedSize;       //KB copied by them
+   } Placement;
+
+//function headers
+Placement *clearPlacement( Placement *placement );
+int compactPlacement( Placement *placement, LiveBlock *liveBlocks,
+                                                         int numBlocks );
+Placement *createPlacement( ConfigDataType *configPtr );
+int findPlacementCode( char *name );
+long getPlacementFragmentation( Placement *placement );
+void getPlacementName( int placeCode, char *outString );
+int placeBlock( Placement *placement, int size );
+void releaseBlock( Placement *placement, int base, int size );
+void releaseProcessPlacements( Placement *placement,
+                                              ProcessControlBlock *pcb );
+
+#endif //PLACEOPS_H
@@ -3,21 +3,25 @@
 #include "configops.h"
 #include "memops.h"
 #include "simtimer.h"
+#include "schedops.h"
+
+//global constants
+const int DEFAULT_TICKETS = 100;
+
+//KB compaction copies per processor cycle
+static const int COMPACT_KB_PER_CYCLE = 64;
 
 /*
 Function Name: addToQueue
 Algorithm: adds to end of queue
 Precondition: given pointer to front of queue or null
 Postcondition: creates new linked list or appends PCB to end 
-               of linked list
+               of linked list, new process is in NEW state
 Exceptions: none
-Notes: none
+Notes: process leaves NEW state through admitNewProcesses
 */
-ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBlock *newPCB,
-                                   ConfigDataType *configPtr, outputNode **outputHead)
+ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBlock *newPCB )
 {
-   char outputLine[MAX_STR_LEN];
-
    //check for local pointer assigned to null
    if(localPtr == NULL )
    {
@@ -25,31 +29,39 @@ ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBl
       localPtr = (ProcessControlBlock *) malloc(sizeof(ProcessControlBlock));
       //assign all values to newly created node
       localPtr->processID = newPCB->processID;
-      localPtr->processState = READY;
+      localPtr->processState = NEW;
       localPtr->allocdMem = newPCB->allocdMem;
+      localPtr->numSegments = newPCB->numSegments;
+      localPtr->maxSegments = newPCB->maxSegments;
+      localPtr->pageTable = newPCB->pageTable;
+      localPtr->numPages = newPCB->numPages;
       localPtr->cpuCyclesLeft = newPCB->cpuCyclesLeft;
-    
-      //report state change
-      char timeBuffer[STD_STR_LEN];
-      double currentTime = accessTimer(LAP_TIMER, timeBuffer);
-      char intBuffer[STD_STR_LEN];
-      sprintf(outputLine, "%f", currentTime);
-      concatenateString(outputLine, ",  OS: Process ");
-      sprintf(intBuffer, "%d", (newPCB)->processID);
- 
-      concatenateString(outputLine, intBuffer);
-      concatenateString(outputLine, " ");
-      concatenateString(outputLine, "set from NEW to READY");
-
-
-      (*outputHead) = addToOutputList(*outputHead, outputLine, configPtr);
-
+      copyString(localPtr->logHeader, newPCB->logHeader);
+      localPtr->logHeaderLength = newPCB->logHeaderLength;
+      localPtr->readyIndex = NOT_IN_HEAP;
+      localPtr->readyPrev = NULL;
+      localPtr->readyNext = NULL;
+      localPtr->schedLevel = 0;
+      localPtr->levelCycles = 0;
+      localPtr->boostEpoch = 0;
+      localPtr->niceValue = newPCB->niceValue;
+      localPtr->virtualRuntime = 0;
+      localPtr->tickets = newPCB->tickets;
+      localPtr->passValue = 0;
+      localPtr->cpuCyclesRun = 0;
+      localPtr->cyclesAtFirstExit = 0;
+      localPtr->relativeDeadline = newPCB->relativeDeadline;
+      localPtr->absoluteDeadline = 0;
+      localPtr->cpuReservation = 0;
+      localPtr->admissionDeferred = False;
+      localPtr->predictedBurst = newPCB->predictedBurst;
   
       localPtr->nextOpCommand = newPCB->nextOpCommand;
       localPtr->timeRemaining = newPCB->timeRemaining;
 
-      //assign next pointer to null
+      //assign next and previous pointers to null
       localPtr->nextNode = NULL;
+      localPtr->prevNode = NULL;
 
 
       //return local pointer
@@ -58,13 +70,98 @@ ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBl
    }
    //assume end of list not found yet
    //assign recursive function to current's next link
-   localPtr->nextNode = addToQueue(localPtr->nextNode, newPCB, configPtr, outputHead);
+   localPtr->nextNode = addToQueue(localPtr->nextNode, newPCB);
+   localPtr->nextNode->prevNode = localPtr;
 
    //return current local pointer
    return localPtr;
   
 }
 
+/*
+Function Name: admitNewProcesses
+Algorithm: asks policy about each NEW process in process ID order;
+           admitted process gets its deadline and is set READY,
+           refused process is set EXITING, deferred process stays NEW
+           and is asked again later
+Precondition: given process queue, output list, config data, and clock
+Postcondition: every NEW process is admitted, refused, or deferred,
+               and each outcome is logged once
+Exceptions: policy without admission test admits every process
+Notes: called when processes are created and after each process exits,
+       since only an exit frees up what a deferred process waits for
+*/
+void admitNewProcesses( ProcessQueue *processQueue, outputNode **outputHead,
+                                ConfigDataType *configPtr, SimClock *simClock )
+{
+   const SchedPolicy *policy = processQueue->policy;
+   ProcessControlBlock *pcb = processQueue->headPtr;
+   ProcessControlBlock *nextPcb;
+   char outputLine[MAX_STR_LEN];
+   int lineLength;
+   int admission;
+   SimTime currentTime;
+
+   while(pcb != NULL && processQueue->stateCounts[ NEW ] > 0)
+   {
+      //refused process leaves active list, so step ahead first
+      nextPcb = pcb->nextNode;
+
+      if(pcb->processState == NEW)
+      {
+         admission = ADMIT_PROCESS;
+         if(policy->admit != NULL)
+         {
+            admission = policy->admit(processQueue, pcb, configPtr);
+         }
+
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         lineLength = startLogLine(outputLine, currentTime);
+         lineLength = appendToLine(outputLine, lineLength, " OS: Process ");
+         lineLength = appendIntToLine(outputLine, lineLength, pcb->processID);
+
+         if(admission == ADMIT_PROCESS)
+         {
+            //deadline counts from admission
+            if(pcb->relativeDeadline > 0)
+            {
+               pcb->absoluteDeadline = currentTime
+                           + (SimTime) pcb->relativeDeadline * NSEC_PER_MSEC;
+            }
+            appendToLine(outputLine, lineLength, " set from NEW to READY");
+            (*outputHead) = addToOutputList(*outputHead, outputLine, 
+                                                                 configPtr);
+            setProcessReady(processQueue, pcb);
+         }
+         else if(admission == REFUSE_PROCESS)
+         {
+            appendToLine(outputLine, lineLength, 
+                             " refused, deadline needs more than whole CPU");
+            (*outputHead) = addToOutputList(*outputHead, outputLine, 
+                                                                 configPtr);
+
+            lineLength = startLogLine(outputLine, currentTime);
+            lineLength = appendToLine(outputLine, lineLength, " OS: Process ");
+            lineLength = appendIntToLine(outputLine, lineLength, 
+                                                            pcb->processID);
+            appendToLine(outputLine, lineLength, " set from NEW to EXITING");
+            (*outputHead) = addToOutputList(*outputHead, outputLine, 
+                                                                 configPtr);
+            setProcessState(processQueue, pcb, EXITING);
+         }
+         else if(pcb->admissionDeferred == False)
+         {
+            appendToLine(outputLine, lineLength, 
+                             " deferred, CPU share already reserved");
+            (*outputHead) = addToOutputList(*outputHead, outputLine, 
+                                                                 configPtr);
+            pcb->admissionDeferred = True;
+         }
+      }
+      pcb = nextPcb;
+   }
+}
+
 /*
 Function Name: calcTimeRemaining 
 Algorithm: iterates through op commands, calculates time,
@@ -99,7 +196,7 @@ int calcTimeRemaining(ProcessControlBlock *pcb, ConfigDataType *configDataPtr)
 }
 
 /*
-Function Name: clearProcessQueue
+Function Name: clearProcessList
 Algorithm: recursively iterates through process linked list,
            returns memory to OS from the bottom of the list upward
 Precondition: linked list, with or without data
@@ -108,16 +205,17 @@ Postcondition: all node memory, if any, is returned to OS,
 Exceptions: none
 Notes: none
 */
-ProcessControlBlock *clearProcessQueue( ProcessControlBlock *localPtr )
+ProcessControlBlock *clearProcessList( ProcessControlBlock *localPtr )
    { 
       //check for local pointer not set to null(list not empty)
       if( localPtr != NULL )
       {      
          //call recursive function with next pointer
-          clearProcessQueue( localPtr->nextNode );      
+          clearProcessList( localPtr->nextNode );      
          //after recursive call, release memory to OS
             //function: free
-         localPtr->allocdMem = clearMemQueue(localPtr->allocdMem);
+         free( localPtr->allocdMem );
+         free( localPtr->pageTable );
          free( localPtr );   
          //set local pointer to null
          localPtr = NULL;
@@ -126,7 +224,143 @@ ProcessControlBlock *clearProcessQueue( ProcessControlBlock *localPtr )
       return NULL;
    }
 
+/*
+Function Name: clearProcessQueue
+Algorithm: releases ready structures, then every process
+Precondition: given process queue or NULL
+Postcondition: all queue memory is returned to OS, NULL is returned
+Exceptions: none
+Notes: none
+*/
+ProcessQueue *clearProcessQueue( ProcessQueue *processQueue )
+{
+   if(processQueue != NULL)
+   {
+      processQueue->policy->clear(processQueue);
+      processQueue->memIndex = clearMemIndex(processQueue->memIndex);
+      processQueue->pagedMemory = 
+                            clearPagedMemory(processQueue->pagedMemory);
+      processQueue->placement = clearPlacement(processQueue->placement);
+      processQueue->headPtr = clearProcessList(processQueue->headPtr);
+      processQueue->exitedPtr = clearProcessList(processQueue->exitedPtr);
+      free(processQueue);
+   }
+   return NULL;
+}
+
+/*
+Function Name: compactMemory
+Algorithm: gathers every live block, has placement slide them together,
+           then logs copy time of each process's blocks and waits out
+           whole copy
+Precondition: given process queue placing blocks with a fit allocator,
+              output list, config data, and clock
+Postcondition: free memory is one block above live blocks, clock has
+               run through copy
+Exceptions: none
+Notes: copying runs one processor cycle per COMPACT_KB_PER_CYCLE KB, or
+       part, of each process's moved blocks; it stalls whole system, so
+       it is not added to any process's time remaining
+*/
+void compactMemory( ProcessQueue *processQueue, outputNode **outputHead,
+                                ConfigDataType *configPtr, SimClock *simClock )
+{
+   char output[MAX_STR_LEN];
+   int outputLength;
+   LiveBlock *liveBlocks;
+   ProcessControlBlock *pcb;
+   int *movedSizes;
+   long fragmentation;
+   int numProcesses = 0;
+   int numBlocks = 0;
+   int movedTotal;
+   int copyTime;
+   int totalTime = 0;
+   int segment;
+   int index;
 
+   //gather blocks of every process still holding memory
+   for(pcb = processQueue->headPtr; pcb != NULL; pcb = pcb->nextNode)
+   {
+      numBlocks += pcb->numSegments;
+   }
+   liveBlocks = (LiveBlock *) malloc(sizeof(LiveBlock) * (numBlocks + 1));
+   numBlocks = 0;
+   for(pcb = processQueue->headPtr; pcb != NULL; pcb = pcb->nextNode)
+   {
+      for(segment = 0; segment < pcb->numSegments; segment++)
+      {
+         liveBlocks[ numBlocks ].block = &pcb->allocdMem[ segment ];
+         liveBlocks[ numBlocks ].owner = pcb;
+         numBlocks++;
+      }
+   }
+
+   outputLength = startLogLine(output, accessTimer(simClock, LAP_TIMER));
+   outputLength = appendToLine(output, outputLength, 
+                                 " OS: Compacting memory, free memory"
+                                          " outside largest free block at ");
+   fragmentation = getPlacementFragmentation(processQueue->placement);
+   outputLength = appendIntToLine(output, outputLength,
+                                                  (int)(fragmentation / 10));
+   outputLength = appendToLine(output, outputLength, ".");
+   outputLength = appendIntToLine(output, outputLength,
+                                                  (int)(fragmentation % 10));
+   appendToLine(output, outputLength, "%");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   movedTotal = compactPlacement(processQueue->placement, liveBlocks,
+                                                                 numBlocks);
+
+   //total KB each process had moved
+   for(index = NEW; index <= EXITING; index++)
+   {
+      numProcesses += processQueue->stateCounts[ index ];
+   }
+   movedSizes = (int *) calloc(numProcesses + 1, sizeof(int));
+   for(index = 0; index < numBlocks; index++)
+   {
+      movedSizes[ liveBlocks[ index ].owner->processID ] 
+                                            += liveBlocks[ index ].movedSize;
+   }
+
+   //log each process's copying, in process ID order
+   for(pcb = processQueue->headPtr; pcb != NULL; pcb = pcb->nextNode)
+   {
+      if(movedSizes[ pcb->processID ] > 0)
+      {
+         copyTime = (movedSizes[ pcb->processID ] + COMPACT_KB_PER_CYCLE - 1)
+                       / COMPACT_KB_PER_CYCLE * configPtr->procCycleRate;
+         totalTime += copyTime;
+
+         outputLength = startLogLine(output, accessTimer(simClock, LAP_TIMER));
+         outputLength = appendToLine(output, outputLength, " OS: Moving ");
+         outputLength = appendIntToLine(output, outputLength,
+                                                movedSizes[ pcb->processID ]);
+         outputLength = appendToLine(output, outputLength, " KB of Process ");
+         outputLength = appendIntToLine(output, outputLength, pcb->processID);
+         outputLength = appendToLine(output, outputLength, " takes ");
+         outputLength = appendIntToLine(output, outputLength, copyTime);
+         appendToLine(output, outputLength, " ms");
+         *outputHead = addToOutputList(*outputHead, output, configPtr);
+      }
+   }
+
+   //copying holds up whole system
+   startTimerRun(simClock);
+   waitTimer(simClock, totalTime);
+
+   outputLength = startLogLine(output, accessTimer(simClock, LAP_TIMER));
+   outputLength = appendToLine(output, outputLength, " OS: Compaction moved ");
+   outputLength = appendIntToLine(output, outputLength, movedTotal);
+   outputLength = appendToLine(output, outputLength, " KB of ");
+   outputLength = appendIntToLine(output, outputLength, numBlocks);
+   appendToLine(output, outputLength, " live blocks");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   free(movedSizes);
+   free(liveBlocks);
+}
 
 
 
@@ -153,15 +387,39 @@ ProcessControlBlock *createPCB( OpCodeType *metaDataPointer,
    //set next op command pointer for this process to current location in meta data
    newPcbPointer->nextOpCommand = metaDataPointer;
 
-   //set process ID
+   //set process ID and log header built from it
    newPcbPointer->processID = processID;
-
-   //set allocated memory to null
-   newPcbPointer->allocdMem = NULL;
+   setLogHeader(newPcbPointer);
+
+   //set nice value, tickets, and deadline to app start arguments, 
+   // tickets default when not given
+   newPcbPointer->niceValue = metaDataPointer->intArg2;
+   newPcbPointer->relativeDeadline = metaDataPointer->intArg4;
+
+   //nothing is known of first CPU burst, so guess one quantum
+   newPcbPointer->predictedBurst = 
+                        configPtr->quantumCycles * configPtr->procCycleRate;
+   newPcbPointer->tickets = metaDataPointer->intArg3;
+   if(newPcbPointer->tickets == 0)
+   {
+      newPcbPointer->tickets = DEFAULT_TICKETS;
+   }
 
    //set cycles left to 0
    newPcbPointer->cpuCyclesLeft = getNextCpuCycles(newPcbPointer);
- 
+
+   //no memory allocated yet
+   newPcbPointer->numSegments = 0;
+   newPcbPointer->maxSegments = 0;
+
+   //list pages process may use, when paging
+   newPcbPointer->pageTable = NULL;
+   newPcbPointer->numPages = 0;
+   if(configPtr->pageSize > 0)
+   {
+      newPcbPointer->pageTable = createPageTable(metaDataPointer,
+                               configPtr->pageSize, &newPcbPointer->numPages);
+   }
 
    //loop until metaDataPointer at app end
    while(!(compareString( metaDataPointer->command, "app") == STR_EQ
@@ -169,6 +427,14 @@ ProcessControlBlock *createPCB( OpCodeType *metaDataPointer,
         {
           //assign process id of op code to processID
           metaDataPointer->pid = processID;
+
+          //count blocks process may allocate
+          if(compareString(metaDataPointer->command, "mem") == STR_EQ
+                && compareString(metaDataPointer->strArg1, "allocate") 
+                                                                   == STR_EQ)
+          {
+             newPcbPointer->maxSegments++;
+          }
           
           //get next op command
           metaDataPointer = metaDataPointer->nextNode;
@@ -178,6 +444,14 @@ ProcessControlBlock *createPCB( OpCodeType *metaDataPointer,
    //set app end pid to proper pid
    metaDataPointer->pid = processID;
 
+   //make room for every block process allocates
+   newPcbPointer->allocdMem = NULL;
+   if(newPcbPointer->maxSegments > 0)
+   {
+      newPcbPointer->allocdMem = 
+           (memBlock *) malloc(sizeof(memBlock) * newPcbPointer->maxSegments);
+   }
+
    //calculate time remaining
    newPcbPointer->timeRemaining = calcTimeRemaining(newPcbPointer, configPtr);
 
@@ -191,16 +465,21 @@ ProcessControlBlock *createPCB( OpCodeType *metaDataPointer,
 Function Name: createProcessQueue
 Algorithm: iterates through meta data list,
            creating process control blocks and 
-           adding to process queue depending on scheduling code
+           adding to process queue depending on scheduling code,
+           then admits processes to the policy's ready structures
 Precondition: given pointer to head of meta data list and scheduling code
-Postcondition: returns pointer to head of queue of process control blocks
+Postcondition: returns process queue holding all processes, each READY
+               unless policy deferred or refused it
 Exceptions: none
 Notes: none
 */
-ProcessControlBlock *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataType *configPtr, outputNode **outputHead)
+ProcessQueue *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataType *configPtr, outputNode **outputHead,
+                                          SimClock *simClock)
 {
    //initialize variables
+      ProcessQueue *processQueue = (ProcessQueue *) malloc(sizeof(ProcessQueue));
       ProcessControlBlock *headPtr = NULL;
+      ProcessControlBlock *tailPtr = NULL;
       ProcessControlBlock *newPcbPtr = NULL;
 
       //initialize number of created processes
@@ -217,9 +496,19 @@ ProcessControlBlock *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataT
       {
          //create PCB
          newPcbPtr = createPCB( metaDataPointer, numProcesses, configPtr );
-         //add PCB to queue
-         headPtr = addToQueue( headPtr, newPcbPtr, configPtr, outputHead );
+         //add PCB behind last one, not from head
+         tailPtr = addToQueue( tailPtr, newPcbPtr );
+         if( headPtr == NULL )
+         {
+            headPtr = tailPtr;
+         }
+         else
+         {
+            tailPtr = tailPtr->nextNode;
+         }
 
+         //queue keeps its own copy
+         free( newPcbPtr );
    
          //increment number of processes
          numProcesses++;
@@ -231,8 +520,36 @@ ProcessControlBlock *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataT
    }
    //end loop
 
-   //return head of process queue
-   return headPtr;
+   //set up ready structures and place every process in them
+   processQueue->headPtr = headPtr;
+   processQueue->exitedPtr = NULL;
+   processQueue->policy = getSchedPolicy(configPtr->cpuSchedCode);
+   processQueue->policy->init(processQueue, numProcesses, configPtr);
+   processQueue->memIndex = createOrderedTree();
+   processQueue->pagedMemory = NULL;
+   if(configPtr->pageSize > 0)
+   {
+      processQueue->pagedMemory = createPagedMemory(configPtr);
+   }
+   processQueue->placement = NULL;
+   if(configPtr->placeCode != PLACE_NONE)
+   {
+      processQueue->placement = createPlacement(configPtr);
+   }
+   processQueue->burstsPredicted = 0;
+   processQueue->burstTimeTotal = 0;
+   processQueue->predictionErrorTotal = 0;
+   processQueue->predictionBiasTotal = 0;
+   processQueue->stateCounts[ NEW ] = numProcesses;
+   for(numProcesses = READY; numProcesses <= EXITING; numProcesses++)
+   {
+      processQueue->stateCounts[ numProcesses ] = 0;
+   }
+
+   admitNewProcesses(processQueue, outputHead, configPtr, simClock);
+
+   //return process queue
+   return processQueue;
 }
 
 /*
@@ -286,61 +603,160 @@ int getNextCpuCycles( ProcessControlBlock *currentProcess )
 }
 
 /*
-Gets next process according to scheduling code stored in configPtr
-Returns next process as parameter in returnedProcess
-Returns PROCESS_AVAILABLE, ALL_PROCESSES_WAITING,
-or ALL_PROCESSES_EXITING via integer
+Function Name: recordCpuBurst
+Algorithm: adds how far process's prediction was off to totals, then
+           moves prediction toward burst by burst weight, as an
+           exponentially weighted average
+Precondition: given process queue, process whose CPU burst just ended,
+              burst time in ms, and config data with burst weight set
+Postcondition: totals and process's prediction are updated
+Exceptions: none
+Notes: with weight alpha, prediction becomes
+       alpha * burst + (1 - alpha) * prediction, rounded to nearest ms
 */
-int getNextProcess( ProcessControlBlock* headPtr,
-                                     ProcessControlBlock* currentProcess,
-                                     ProcessControlBlock **returnedProcess,
-                                     ConfigDataType *configPtr )
+void recordCpuBurst( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                    int burstTime, ConfigDataType *configPtr )
 {
-   //check for current process null (meaning beginning of loop) 
-   if(currentProcess == NULL)
+   const int FULL_WEIGHT = 100;
+   int error = pcb->predictedBurst - burstTime;
+
+   processQueue->burstsPredicted++;
+   processQueue->burstTimeTotal += burstTime;
+   processQueue->predictionBiasTotal += error;
+   if(error < 0)
    {
-      currentProcess = headPtr;
+      error = -error;
+   }
+   processQueue->predictionErrorTotal += error;
 
-      if(configPtr->cpuSchedCode == CPU_SCHED_FCFS_N_CODE 
-             || configPtr->cpuSchedCode == CPU_SCHED_FCFS_P_CODE
-             || configPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE)
+   pcb->predictedBurst = (configPtr->burstAlpha * burstTime
+                + (FULL_WEIGHT - configPtr->burstAlpha) * pcb->predictedBurst
+                + FULL_WEIGHT / 2) / FULL_WEIGHT;
+}
+
+/*
+Function Name: setProcessReady
+Algorithm: tells policy of a process waking from I/O, sets process state
+           to READY, and hands process to policy
+Precondition: given process queue and process that is not READY
+Postcondition: process is READY and can be picked by getNextProcess
+Exceptions: no effect on a process that is already READY
+Notes: every move to READY goes through here
+*/
+void setProcessReady( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   const SchedPolicy *policy = processQueue->policy;
+
+   if(pcb->processState != READY)
+   {
+      if(pcb->processState == WAITING && policy->onWake != NULL)
       {
-         *returnedProcess = currentProcess;
-         (*returnedProcess)->processState = RUNNING;
-         return PROCESS_AVAILABLE;
+         policy->onWake(processQueue, pcb);
       }
+      setProcessState(processQueue, pcb, READY);
+      policy->enqueue(processQueue, pcb);
    }
-   
-   int numWaiting = 0;
+}
+
+/*
+Function Name: setProcessState
+Algorithm: moves process from its state count to the new one, telling
+           policy of moves to WAITING and to EXITING; on exit
+           also unlinks process from active list, keeps it on exited list,
+           and returns its memory
+Precondition: given process queue, process on active list, and new state
+Postcondition: process is in new state and counts match
+Exceptions: none
+Notes: every state change after process creation goes through here,
+       so state counts never need a scan; O(1), except first exit, which
+       notes CPU cycles run by every process
+*/
+void setProcessState( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                              int newState )
+{
+   ProcessControlBlock *activePtr;
 
-   int numExiting = 0;
+   processQueue->stateCounts[ pcb->processState ]--;
+   processQueue->stateCounts[ newState ]++;
+   pcb->processState = newState;
 
-   int totalProcesses = 0; 
+   if(newState == WAITING && processQueue->policy->onBlock != NULL)
+   {
+      processQueue->policy->onBlock(processQueue, pcb);
+   }
 
-   ProcessControlBlock *tempPtr = headPtr;
-   while(tempPtr != NULL)
+   if(newState == EXITING)
    {
-      if(tempPtr->processState == WAITING)
+      if(processQueue->policy->onExit != NULL)
       {
-         numWaiting++;
+         processQueue->policy->onExit(processQueue, pcb);
       }
-      if(tempPtr->processState == EXITING)
+
+      //note CPU use while every process was still competing
+      if(processQueue->stateCounts[ EXITING ] == 1)
       {
-         numExiting++;
+         for(activePtr = processQueue->headPtr; activePtr != NULL;
+                                         activePtr = activePtr->nextNode)
+         {
+            activePtr->cyclesAtFirstExit = activePtr->cpuCyclesRun;
+         }
+      }
+
+      //unlink from active list
+      if(pcb->prevNode == NULL)
+      {
+         processQueue->headPtr = pcb->nextNode;
+      }
+      else
+      {
+         pcb->prevNode->nextNode = pcb->nextNode;
+      }
+      if(pcb->nextNode != NULL)
+      {
+         pcb->nextNode->prevNode = pcb->prevNode;
       }
-      totalProcesses++;
-      tempPtr = tempPtr->nextNode;
 
+      //keep on exited list, caller may still hold it
+      pcb->prevNode = NULL;
+      pcb->nextNode = processQueue->exitedPtr;
+      processQueue->exitedPtr = pcb;
+
+      //memory is no longer in use
+      if(processQueue->placement != NULL)
+      {
+         releaseProcessPlacements(processQueue->placement, pcb);
+      }
+      releaseProcessMemory(processQueue->memIndex, pcb);
+      if(processQueue->pagedMemory != NULL)
+      {
+         releaseProcessPages(processQueue->pagedMemory, pcb);
+      }
    }
+}
+
+/*
+Gets next process from scheduling policy of process queue
+Returns next process as parameter in returnedProcess
+Returns PROCESS_AVAILABLE, ALL_PROCESSES_WAITING,
+or ALL_PROCESSES_EXITING via integer
+*/
+int getNextProcess( ProcessQueue *processQueue,
+                                     ProcessControlBlock* currentProcess,
+                                     ProcessControlBlock **returnedProcess,
+                                     ConfigDataType *configPtr )
+{
+   int *stateCounts = processQueue->stateCounts;
 
    //return all waiting if there's at least one waiting process
    //and all non-waiting processes are done (exiting)
-   if(numWaiting > 0 && (numWaiting+numExiting)==totalProcesses)
+   if(stateCounts[ WAITING ] > 0 && stateCounts[ READY ] == 0 
+         && stateCounts[ RUNNING ] == 0)
    {
       return ALL_PROCESSES_WAITING;
    }
 
-   if(numExiting==totalProcesses)
+   //no active process left
+   if(processQueue->headPtr == NULL)
    {
       return ALL_PROCESSES_EXITING;
    }
@@ -348,90 +764,13 @@ int getNextProcess( ProcessControlBlock* headPtr,
    //initalize next process to null
    ProcessControlBlock *nextProcess = NULL;
 
-   //check for FCFS
-   if(configPtr->cpuSchedCode == CPU_SCHED_FCFS_N_CODE 
-         || configPtr->cpuSchedCode == CPU_SCHED_FCFS_P_CODE)
-   {
-      nextProcess = headPtr;
-      //if FCFS and not at beginning, return next ready process
-      while(nextProcess != NULL && nextProcess->processState != READY)
-      {
-         nextProcess = nextProcess->nextNode;
-      }
-   }
-
-  //check for RR
-  if(configPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE)
-  {
-     //loop back to beginning if already at the end
-     if(currentProcess->nextNode == NULL)
-     {
-        nextProcess = headPtr;
-     }
-     //otherwise, start at next process
-     else
-     {
-        nextProcess = currentProcess->nextNode;
-     }
-     while( nextProcess->processState != READY)
-     {
-        //move forward
-        nextProcess = nextProcess->nextNode;
-        //if we reached end, move back to beginning 
-        if(nextProcess == NULL)
-        {
-           nextProcess = headPtr;
-        }
-     }
-  }
-
-
-   //check for SJF-N or SRTF-P
-   if(configPtr->cpuSchedCode == CPU_SCHED_SJF_N_CODE || configPtr->cpuSchedCode == CPU_SCHED_SRTF_P_CODE)
-   {
-      //get first ready process if there is one
-      nextProcess = headPtr;
-      while(nextProcess != NULL && nextProcess->processState != READY)
-      {
-        nextProcess = nextProcess->nextNode;        
-      }
-      //make sure we got a process 
-      if(nextProcess != NULL)
-      {
-   
-         int minRunTime = nextProcess->timeRemaining;
-         ProcessControlBlock *processToCompare = nextProcess->nextNode; 
-         int currentRunTime;
-         //iterate through processes
-         while(processToCompare != NULL)
-         {
-           //check if current process is ready
-           if(processToCompare->processState == READY)
-           {
-
-             currentRunTime = processToCompare->timeRemaining;
-             //check if this process's next burst is less than currently chosen process
-             if(currentRunTime < minRunTime)
-             {
-                //if yes, set chosen process to this process  
-                minRunTime = currentRunTime;
-                nextProcess = processToCompare;
-             }
-            //get another process to check
-
-           }
-            processToCompare = processToCompare->nextNode;
-         }
-
+   //policy picks from its own ready structure
+   nextProcess = processQueue->policy->dequeueNext(processQueue);
 
-      }
-          
-   } 
-   //end loop	
    *returnedProcess = nextProcess;
    if((*returnedProcess)!=NULL)
    {
-      (*returnedProcess)->processState = RUNNING;
+      setProcessState(processQueue, *returnedProcess, RUNNING);
    }
   
    //return next process
@@ -3,6 +3,14 @@
 #define PROCESSOPS_H
 
 #include "metadataops.h"
+#include "simtimer.h"
+#include "heapops.h"
+#include "treeops.h"
+#include "pageops.h"
+#include "placeops.h"
+
+//constants
+extern const int DEFAULT_TICKETS;
 
 //process states
 typedef enum { NEW,
@@ -15,20 +23,50 @@ typedef enum { PROCESS_AVAILABLE,
                ALL_PROCESSES_WAITING,
                ALL_PROCESSES_EXITING } processListStatusCodes;
 
+typedef struct ProcessQueue
+   {
+      ProcessControlBlock *headPtr;   //active processes, in process ID order
+      ProcessControlBlock *exitedPtr; //exited processes, kept until run ends
+      int stateCounts[ EXITING + 1 ]; //number of processes in each state
+      const struct SchedPolicy *policy; //scheduling policy in use
+      OrderedTree *memIndex;          //live memory blocks of every process,
+                                      // by lower bound
+      PagedMemory *pagedMemory;       //frames and TLB, NULL without paging
+      Placement *placement;           //allocator placing blocks, NULL
+                                      // when ops place them
+      void *readyData;                //READY processes, kept however the
+                                      // policy likes
+      int burstsPredicted;            //CPU bursts run with a prediction
+      long burstTimeTotal;            //ms of those bursts
+      long predictionErrorTotal;      //ms each prediction was off by
+      long predictionBiasTotal;       //ms each prediction was over, less
+                                      // ms each was under
+   } ProcessQueue;
+
 //method headers
-ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBlock *newPCB,
-                                   ConfigDataType *configPtr, outputNode **outputHead);
+ProcessControlBlock *addToQueue( ProcessControlBlock *localPtr, ProcessControlBlock *newPCB );
+void admitNewProcesses( ProcessQueue *processQueue, outputNode **outputHead,
+                                ConfigDataType *configPtr, SimClock *simClock );
 int calcTimeRemaining(ProcessControlBlock *pcb, ConfigDataType *configDataPtr);
-ProcessControlBlock *clearProcessQueue( ProcessControlBlock *localPtr );
+ProcessControlBlock *clearProcessList( ProcessControlBlock *localPtr );
+ProcessQueue *clearProcessQueue( ProcessQueue *processQueue );
+void compactMemory( ProcessQueue *processQueue, outputNode **outputHead,
+                               ConfigDataType *configPtr, SimClock *simClock );
 ProcessControlBlock *createPCB( OpCodeType *metaDataPointer, int processID, ConfigDataType *configPtr);
-ProcessControlBlock *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataType *configPtr, outputNode **outputHead);
+ProcessQueue *createProcessQueue(OpCodeType *metaDataPointer, ConfigDataType *configPtr, outputNode **outputHead,
+                                          SimClock *simClock);
 int getNextCpuBurst( ProcessControlBlock *currentProcess, ConfigDataType *configPtr );
 int getNextCpuCycles( ProcessControlBlock *currentProcess);
-int getNextProcess( ProcessControlBlock* headPtr,
+int getNextProcess( ProcessQueue *processQueue,
                                      ProcessControlBlock* currentProcess,
                                      ProcessControlBlock **returnedProcess,
                                      ConfigDataType *configPtr );
 char *getOutput( OpCodeType opCommand );
+void recordCpuBurst( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                   int burstTime, ConfigDataType *configPtr );
+void setProcessReady( ProcessQueue *processQueue, ProcessControlBlock *pcb );
+void setProcessState( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                             int newState );
 
 
 
@@ -0,0 +1,1252 @@
+#include "schedops.h"
+#include "configops.h"
+#include "heapops.h"
+#include "treeops.h"
+#include "fenwickops.h"
+#include <limits.h>
+
+//CFS weight of each nice value from 0 to 19, each step is about 10%
+// less CPU time; same as Linux
+static const int NICE_WEIGHTS[] = { 1024, 820, 655, 526, 423, 335, 272, 215,
+                                     172, 137, 110, 87, 70, 56, 45, 36, 29,
+                                     23, 18, 15 };
+static const int NICE_0_WEIGHT = 1024;
+static const int MAX_NICE_VALUE = 19;
+
+//CFS target latency, in configured quanta
+static const int CFS_LATENCY_QUANTA = 8;
+
+//stride of a process with one ticket
+static const SimTime STRIDE_ONE = 1 << 20;
+
+//lottery draw generator seed, fixed so runs can be repeated
+static const uint64_t LOTTERY_SEED = 0x9E3779B97F4A7C15ULL;
+
+//EDF CPU share of whole CPU, in millionths
+static const SimTime WHOLE_CPU_SHARE = 1000000;
+
+//EDF heap key of process without deadline, after every deadline
+static const SimTime NO_DEADLINE_KEY = INT64_MAX;
+
+/*
+Function Name: pushRing
+Algorithm: links process in behind newest process of ring
+Precondition: given pointer to oldest process of ring, or to NULL, and
+              process not in any ring
+Postcondition: process is newest in ring
+Exceptions: none
+Notes: ring is linked through the processes, so needs no storage; O(1)
+*/
+static void pushRing( ProcessControlBlock **ringPtr, ProcessControlBlock *pcb )
+{
+   ProcessControlBlock *oldest = *ringPtr;
+
+   if(oldest == NULL)
+   {
+      pcb->readyPrev = pcb;
+      pcb->readyNext = pcb;
+      *ringPtr = pcb;
+   }
+   else
+   {
+      pcb->readyPrev = oldest->readyPrev;
+      pcb->readyNext = oldest;
+      oldest->readyPrev->readyNext = pcb;
+      oldest->readyPrev = pcb;
+   }
+}
+
+/*
+Function Name: popRing
+Algorithm: unlinks oldest process of ring
+Precondition: given pointer to oldest process of ring, or to NULL
+Postcondition: returns oldest process, no longer in ring, or NULL if empty
+Exceptions: none
+Notes: O(1)
+*/
+static ProcessControlBlock *popRing( ProcessControlBlock **ringPtr )
+{
+   ProcessControlBlock *oldest = *ringPtr;
+
+   if(oldest == NULL)
+   {
+      return NULL;
+   }
+
+   if(oldest->readyNext == oldest)
+   {
+      *ringPtr = NULL;
+   }
+   else
+   {
+      oldest->readyPrev->readyNext = oldest->readyNext;
+      oldest->readyNext->readyPrev = oldest->readyPrev;
+      *ringPtr = oldest->readyNext;
+   }
+
+   oldest->readyPrev = NULL;
+   oldest->readyNext = NULL;
+   return oldest;
+}
+
+/*
+Function Name: spliceRing
+Algorithm: links all of second ring in behind newest process of first
+Precondition: given pointers to oldest processes of two rings
+Postcondition: first ring holds both, in order, second ring is empty
+Exceptions: none
+Notes: O(1)
+*/
+static void spliceRing( ProcessControlBlock **toRingPtr,
+                                         ProcessControlBlock **fromRingPtr )
+{
+   ProcessControlBlock *toOldest = *toRingPtr;
+   ProcessControlBlock *fromOldest = *fromRingPtr;
+   ProcessControlBlock *toNewest;
+
+   if(fromOldest == NULL)
+   {
+      return;
+   }
+
+   if(toOldest == NULL)
+   {
+      *toRingPtr = fromOldest;
+   }
+   else
+   {
+      toNewest = toOldest->readyPrev;
+      toNewest->readyNext = fromOldest;
+      toOldest->readyPrev = fromOldest->readyPrev;
+      fromOldest->readyPrev->readyNext = toOldest;
+      fromOldest->readyPrev = toNewest;
+   }
+   *fromRingPtr = NULL;
+}
+
+/*
+Function Name: initReadyRing
+Algorithm: starts with empty ring
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds oldest READY process, none yet
+Exceptions: none
+Notes: none
+*/
+static void initReadyRing( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: clearReadyRing
+Algorithm: forgets ring
+Precondition: given process queue
+Postcondition: ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearReadyRing( ProcessQueue *processQueue )
+{
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushReadyRing
+Algorithm: adds process as newest of queue's ring
+Precondition: given process queue and process not in ring
+Postcondition: process is newest in ring
+Exceptions: none
+Notes: O(1)
+*/
+static void pushReadyRing( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   ProcessControlBlock *oldest = (ProcessControlBlock *) processQueue->readyData;
+
+   pushRing(&oldest, pcb);
+   processQueue->readyData = oldest;
+}
+
+/*
+Function Name: popReadyRing
+Algorithm: takes oldest process of queue's ring
+Precondition: given process queue
+Postcondition: returns oldest process, no longer in ring, or NULL if empty
+Exceptions: none
+Notes: O(1)
+*/
+static ProcessControlBlock *popReadyRing( ProcessQueue *processQueue )
+{
+   ProcessControlBlock *oldest = (ProcessControlBlock *) processQueue->readyData;
+   ProcessControlBlock *popped = popRing(&oldest);
+
+   processQueue->readyData = oldest;
+   return popped;
+}
+
+/*
+Function Name: initShortestHeap
+Algorithm: creates heap with room for every process, notes whether
+           bursts are predicted
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds shortest first data with empty heap
+Exceptions: none
+Notes: none
+*/
+static void initShortestHeap( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   ShortestData *shortest = (ShortestData *) malloc(sizeof(ShortestData));
+
+   shortest->timeQueue = createMinHeap(numProcesses);
+   shortest->predictBursts = configPtr->burstAlpha > 0;
+   shortest->cycleRate = configPtr->procCycleRate;
+
+   processQueue->readyData = shortest;
+}
+
+/*
+Function Name: clearShortestHeap
+Algorithm: releases heap and shortest first data
+Precondition: given process queue
+Postcondition: shortest first memory freed, ready data is NULL
+Exceptions: none
+Notes: none
+*/
+static void clearShortestHeap( ProcessQueue *processQueue )
+{
+   ShortestData *shortest = (ShortestData *) processQueue->readyData;
+
+   shortest->timeQueue = clearMinHeap(shortest->timeQueue);
+   free(shortest);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: getShortestKey
+Algorithm: reads exact time remaining, or takes time already run in
+           current CPU burst from predicted burst
+Precondition: given shortest first data and READY process
+Postcondition: returns ms process is expected to need
+Exceptions: prediction already used up counts as nothing left
+Notes: prediction only knows the next burst, so I/O and later bursts
+       do not count against it
+*/
+static SimTime getShortestKey( ShortestData *shortest,
+                                              ProcessControlBlock *pcb )
+{
+   OpCodeType *opPtr = pcb->nextOpCommand;
+   int burstTimeLeft = pcb->predictedBurst;
+
+   if(shortest->predictBursts == False)
+   {
+      return pcb->timeRemaining;
+   }
+
+   //CPU burst cut short by preemption has run part of its cycles
+   if(compareString(opPtr->command, "cpu") == STR_EQ
+                                              && pcb->cpuCyclesLeft > 0)
+   {
+      burstTimeLeft -= (opPtr->intArg2 - pcb->cpuCyclesLeft)
+                                                     * shortest->cycleRate;
+   }
+   if(burstTimeLeft < 0)
+   {
+      burstTimeLeft = 0;
+   }
+   return burstTimeLeft;
+}
+
+/*
+Function Name: pushShortestHeap
+Algorithm: inserts process keyed by time remaining, then process ID
+Precondition: given process queue and READY process not in heap
+Postcondition: process is in heap
+Exceptions: none
+Notes: time remaining only changes while a process runs, so the key is
+       set once on entry; equal times go to the lower process ID, as a
+       front to back scan would; O(log n)
+*/
+static void pushShortestHeap( ProcessQueue *processQueue,
+                                              ProcessControlBlock *pcb )
+{
+   ShortestData *shortest = (ShortestData *) processQueue->readyData;
+
+   insertHeapItem(shortest->timeQueue, getShortestKey(shortest, pcb),
+                                    pcb->processID, pcb, &pcb->readyIndex);
+}
+
+/*
+Function Name: popShortestHeap
+Algorithm: removes process with least time remaining
+Precondition: given process queue
+Postcondition: returns that process, or NULL if heap is empty
+Exceptions: none
+Notes: O(log n)
+*/
+static ProcessControlBlock *popShortestHeap( ProcessQueue *processQueue )
+{
+   ShortestData *shortest = (ShortestData *) processQueue->readyData;
+
+   return (ProcessControlBlock *) popHeapItem(shortest->timeQueue);
+}
+
+/*
+Function Name: getConfigQuantum
+Algorithm: reads quantum from config data
+Precondition: given process queue, running process, and config data
+Postcondition: returns configured quantum cycles
+Exceptions: none
+Notes: same slice for every process
+*/
+static int getConfigQuantum( ProcessQueue *processQueue,
+                       ProcessControlBlock *pcb, ConfigDataType *configPtr )
+{
+   return configPtr->quantumCycles;
+}
+
+/*
+Function Name: preemptAlways
+Algorithm: none
+Precondition: given process queue, running process, and woken process
+Postcondition: returns true, every I/O end takes the CPU
+Exceptions: none
+Notes: woken process and running one then compete in ready structure
+*/
+static Boolean preemptAlways( ProcessQueue *processQueue,
+                                          ProcessControlBlock *running,
+                                          ProcessControlBlock *woken )
+{
+   return True;
+}
+
+/*
+Function Name: getLevelQuantum
+Algorithm: doubles top level quantum once per level down
+Precondition: given MLFQ data and level
+Postcondition: returns cycles a process may run at that level
+Exceptions: none
+Notes: zero quantum means no time slicing at any level
+*/
+static int getLevelQuantum( MlfqData *mlfq, int level )
+{
+   return mlfq->baseQuantum << level;
+}
+
+/*
+Function Name: catchUpBoost
+Algorithm: moves process to top level if a boost happened since it
+           was last looked at
+Precondition: given MLFQ data and process
+Postcondition: process level reflects every boost so far
+Exceptions: none
+Notes: boost only relinks ready rings, every other process is caught up
+       here when next seen, so a boost never walks the process list
+*/
+static void catchUpBoost( MlfqData *mlfq, ProcessControlBlock *pcb )
+{
+   if(pcb->boostEpoch != mlfq->boostEpoch)
+   {
+      pcb->schedLevel = 0;
+      pcb->levelCycles = 0;
+      pcb->boostEpoch = mlfq->boostEpoch;
+   }
+}
+
+/*
+Function Name: initMlfq
+Algorithm: creates empty ring per level, sets top quantum from configured
+           quantum, and boost period to one bottom level quantum for
+           every process
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds MLFQ data
+Exceptions: none
+Notes: a shorter period would boost processes before they ever reach
+       the lower levels
+*/
+static void initMlfq( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   MlfqData *mlfq = (MlfqData *) malloc(sizeof(MlfqData));
+   int level;
+
+   for(level = 0; level < MLFQ_LEVELS; level++)
+   {
+      mlfq->levelRings[ level ] = NULL;
+   }
+   mlfq->baseQuantum = configPtr->quantumCycles;
+   mlfq->boostCycles = (long)getLevelQuantum(mlfq, MLFQ_LEVELS - 1)
+                                                              * numProcesses;
+   mlfq->cyclesSinceBoost = 0;
+   mlfq->boostEpoch = 0;
+
+   processQueue->readyData = mlfq;
+}
+
+/*
+Function Name: clearMlfq
+Algorithm: releases MLFQ data
+Precondition: given process queue
+Postcondition: MLFQ data freed, ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearMlfq( ProcessQueue *processQueue )
+{
+   free(processQueue->readyData);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushMlfq
+Algorithm: adds process as newest of its level's ring
+Precondition: given process queue and READY process not in any ring
+Postcondition: process is in ring of its level
+Exceptions: none
+Notes: O(1)
+*/
+static void pushMlfq( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   MlfqData *mlfq = (MlfqData *) processQueue->readyData;
+
+   catchUpBoost(mlfq, pcb);
+   pushRing(&mlfq->levelRings[ pcb->schedLevel ], pcb);
+}
+
+/*
+Function Name: popMlfq
+Algorithm: takes oldest process of highest level with any READY process
+Precondition: given process queue
+Postcondition: returns that process, or NULL if every ring is empty
+Exceptions: none
+Notes: O(1), at most one look per level
+*/
+static ProcessControlBlock *popMlfq( ProcessQueue *processQueue )
+{
+   MlfqData *mlfq = (MlfqData *) processQueue->readyData;
+   int level;
+
+   for(level = 0; level < MLFQ_LEVELS; level++)
+   {
+      if(mlfq->levelRings[ level ] != NULL)
+      {
+         return popRing(&mlfq->levelRings[ level ]);
+      }
+   }
+   return NULL;
+}
+
+/*
+Function Name: tickMlfq
+Algorithm: charges cycles to process's level, demoting it once it has run
+           a full quantum there; boosts every process to top level once
+           boost period has passed
+Precondition: given process queue, running process, and cycles it just ran
+Postcondition: level, cycle counts, and boost state are updated
+Exceptions: none
+Notes: cycles at a level add up across I/O, so blocking just before the
+       quantum ends does not keep a process at a high level; a boost
+       splices lower rings onto top ring, O(levels)
+*/
+static void tickMlfq( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                               int cyclesRun )
+{
+   MlfqData *mlfq = (MlfqData *) processQueue->readyData;
+   int levelQuantum;
+   int level;
+
+   catchUpBoost(mlfq, pcb);
+
+   //demote once quantum at this level is used up
+   levelQuantum = getLevelQuantum(mlfq, pcb->schedLevel);
+   pcb->levelCycles += cyclesRun;
+   if(levelQuantum > 0 && pcb->levelCycles >= levelQuantum)
+   {
+      if(pcb->schedLevel < MLFQ_LEVELS - 1)
+      {
+         pcb->schedLevel++;
+      }
+      pcb->levelCycles = 0;
+   }
+
+   //boost everything back to top level
+   mlfq->cyclesSinceBoost += cyclesRun;
+   if(mlfq->boostCycles > 0 && mlfq->cyclesSinceBoost >= mlfq->boostCycles)
+   {
+      for(level = 1; level < MLFQ_LEVELS; level++)
+      {
+         spliceRing(&mlfq->levelRings[ 0 ], &mlfq->levelRings[ level ]);
+      }
+      mlfq->cyclesSinceBoost = 0;
+      mlfq->boostEpoch++;
+   }
+}
+
+/*
+Function Name: getMlfqQuantum
+Algorithm: finds cycles left of quantum at process's level
+Precondition: given process queue, process being dispatched, config data
+Postcondition: returns cycles process may run before quantum time out
+Exceptions: none
+Notes: process that ran part of its quantum before blocking only gets
+       the rest of it
+*/
+static int getMlfqQuantum( ProcessQueue *processQueue,
+                       ProcessControlBlock *pcb, ConfigDataType *configPtr )
+{
+   MlfqData *mlfq = (MlfqData *) processQueue->readyData;
+
+   catchUpBoost(mlfq, pcb);
+   if(getLevelQuantum(mlfq, pcb->schedLevel) == 0)
+   {
+      return 0;
+   }
+   return getLevelQuantum(mlfq, pcb->schedLevel) - pcb->levelCycles;
+}
+
+/*
+Function Name: preemptIfHigher
+Algorithm: compares levels of woken and running processes
+Precondition: given process queue, running process, and woken process
+Postcondition: returns true if woken process is at a higher level
+Exceptions: none
+Notes: I/O bound processes stay high, so they take CPU from CPU bound
+       ones as soon as their I/O ends
+*/
+static Boolean preemptIfHigher( ProcessQueue *processQueue,
+                                          ProcessControlBlock *running,
+                                          ProcessControlBlock *woken )
+{
+   MlfqData *mlfq = (MlfqData *) processQueue->readyData;
+
+   catchUpBoost(mlfq, running);
+   catchUpBoost(mlfq, woken);
+   return woken->schedLevel < running->schedLevel;
+}
+
+/*
+Function Name: getNiceWeight
+Algorithm: looks up weight of process's nice value, clamped to table
+Precondition: given process
+Postcondition: returns process's CFS weight
+Exceptions: nice values past 19 are treated as 19
+Notes: none
+*/
+static int getNiceWeight( ProcessControlBlock *pcb )
+{
+   if(pcb->niceValue > MAX_NICE_VALUE)
+   {
+      return NICE_WEIGHTS[ MAX_NICE_VALUE ];
+   }
+   return NICE_WEIGHTS[ pcb->niceValue ];
+}
+
+/*
+Function Name: placeWoken
+Algorithm: raises virtual runtime of process back from I/O to no less than
+           half a target latency behind least runtime dispatched
+Precondition: given CFS data and process whose I/O has ended
+Postcondition: process cannot claim more than half a latency of CPU
+               for time spent waiting
+Exceptions: none
+Notes: safe to repeat
+*/
+static void placeWoken( CfsData *cfs, ProcessControlBlock *pcb )
+{
+   SimTime floorRuntime = cfs->minRuntime 
+                     - (SimTime)cfs->latencyCycles * NICE_0_WEIGHT / 2;
+
+   if(pcb->virtualRuntime < floorRuntime)
+   {
+      pcb->virtualRuntime = floorRuntime;
+   }
+}
+
+/*
+Function Name: initCfs
+Algorithm: creates empty timeline, sets target latency and shortest slice
+           from configured quantum
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds CFS data
+Exceptions: none
+Notes: zero quantum means no time slicing
+*/
+static void initCfs( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   CfsData *cfs = (CfsData *) malloc(sizeof(CfsData));
+
+   cfs->timeline = createOrderedTree();
+   cfs->minRuntime = 0;
+   cfs->readyWeight = 0;
+   cfs->latencyCycles = configPtr->quantumCycles * CFS_LATENCY_QUANTA;
+   cfs->minSliceCycles = configPtr->quantumCycles / 2;
+   if(cfs->minSliceCycles < 1)
+   {
+      cfs->minSliceCycles = 1;
+   }
+
+   processQueue->readyData = cfs;
+}
+
+/*
+Function Name: clearCfs
+Algorithm: releases timeline and CFS data
+Precondition: given process queue
+Postcondition: CFS memory freed, ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearCfs( ProcessQueue *processQueue )
+{
+   CfsData *cfs = (CfsData *) processQueue->readyData;
+
+   cfs->timeline = clearOrderedTree(cfs->timeline);
+   free(cfs);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushCfs
+Algorithm: inserts process into timeline by virtual runtime, then
+           process ID, and adds its weight to ready weight
+Precondition: given process queue and READY process not in timeline
+Postcondition: process is in timeline
+Exceptions: none
+Notes: O(log n)
+*/
+static void pushCfs( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   CfsData *cfs = (CfsData *) processQueue->readyData;
+
+   insertTreeItem(cfs->timeline, pcb->virtualRuntime, pcb->processID, pcb);
+   cfs->readyWeight += getNiceWeight(pcb);
+}
+
+/*
+Function Name: popCfs
+Algorithm: removes leftmost process of timeline, the one with least
+           virtual runtime, and moves least runtime up to it
+Precondition: given process queue
+Postcondition: returns that process, or NULL if timeline is empty
+Exceptions: none
+Notes: O(log n)
+*/
+static ProcessControlBlock *popCfs( ProcessQueue *processQueue )
+{
+   CfsData *cfs = (CfsData *) processQueue->readyData;
+   ProcessControlBlock *nextProcess =
+                         (ProcessControlBlock *) popTreeMin(cfs->timeline);
+
+   if(nextProcess != NULL)
+   {
+      cfs->readyWeight -= getNiceWeight(nextProcess);
+      if(nextProcess->virtualRuntime > cfs->minRuntime)
+      {
+         cfs->minRuntime = nextProcess->virtualRuntime;
+      }
+   }
+   return nextProcess;
+}
+
+/*
+Function Name: tickCfs
+Algorithm: adds cycles run to virtual runtime, scaled by nice weight
+Precondition: given process queue, running process, and cycles it just ran
+Postcondition: virtual runtime is updated
+Exceptions: none
+Notes: a nice 0 process gains 1024 per cycle, lighter ones gain more
+*/
+static void tickCfs( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                               int cyclesRun )
+{
+   pcb->virtualRuntime += (SimTime)cyclesRun * NICE_0_WEIGHT * NICE_0_WEIGHT 
+                                                       / getNiceWeight(pcb);
+}
+
+/*
+Function Name: wakeCfs
+Algorithm: places process back from I/O near front of timeline
+Precondition: given process queue and process whose I/O has ended
+Postcondition: process runtime is ready for it to be enqueued
+Exceptions: none
+Notes: none
+*/
+static void wakeCfs( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   placeWoken((CfsData *) processQueue->readyData, pcb);
+}
+
+/*
+Function Name: getCfsSlice
+Algorithm: splits target latency among dispatched and READY processes by
+           weight, giving no less than shortest slice
+Precondition: given process queue, process being dispatched, config data
+Postcondition: returns cycles process may run before quantum time out
+Exceptions: none
+Notes: slices shrink as more processes are runnable, so each still runs
+       once per latency until shortest slice is reached
+*/
+static int getCfsSlice( ProcessQueue *processQueue,
+                       ProcessControlBlock *pcb, ConfigDataType *configPtr )
+{
+   CfsData *cfs = (CfsData *) processQueue->readyData;
+   long weight = getNiceWeight(pcb);
+   long sliceCycles;
+
+   if(cfs->latencyCycles == 0)
+   {
+      return 0;
+   }
+
+   sliceCycles = cfs->latencyCycles * weight / (cfs->readyWeight + weight);
+   if(sliceCycles < cfs->minSliceCycles)
+   {
+      sliceCycles = cfs->minSliceCycles;
+   }
+   return (int)sliceCycles;
+}
+
+/*
+Function Name: preemptIfBehind
+Algorithm: places woken process, then compares virtual runtimes
+Precondition: given process queue, running process, and woken process
+Postcondition: returns true if woken process is more than a shortest
+               slice of nice 0 runtime behind running one
+Exceptions: none
+Notes: margin keeps processes from trading CPU on every I/O end
+*/
+static Boolean preemptIfBehind( ProcessQueue *processQueue,
+                                          ProcessControlBlock *running,
+                                          ProcessControlBlock *woken )
+{
+   CfsData *cfs = (CfsData *) processQueue->readyData;
+
+   placeWoken(cfs, woken);
+   return woken->virtualRuntime 
+                  + (SimTime)cfs->minSliceCycles * NICE_0_WEIGHT
+                                                  < running->virtualRuntime;
+}
+
+/*
+Function Name: preemptNever
+Algorithm: none
+Precondition: given process queue, running process, and woken process
+Postcondition: returns false, running process keeps CPU to end of quantum
+Exceptions: none
+Notes: shares are settled at each quantum end, an I/O end changes nothing
+*/
+static Boolean preemptNever( ProcessQueue *processQueue,
+                                          ProcessControlBlock *running,
+                                          ProcessControlBlock *woken )
+{
+   return False;
+}
+
+/*
+Function Name: nextRandom
+Algorithm: xorshift step of state, then multiply
+Precondition: given lottery data
+Postcondition: returns next 64 bit pseudo random number, state is advanced
+Exceptions: none
+Notes: state must not be zero
+*/
+static uint64_t nextRandom( LotteryData *lottery )
+{
+   uint64_t state = lottery->randomState;
+
+   state ^= state >> 12;
+   state ^= state << 25;
+   state ^= state >> 27;
+   lottery->randomState = state;
+
+   return state * 0x2545F4914F6CDD1DULL;
+}
+
+/*
+Function Name: initLottery
+Algorithm: creates ticket tree and process table indexed by process ID,
+           seeds draw generator
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds lottery data
+Exceptions: none
+Notes: process IDs run from zero to number of processes - 1
+*/
+static void initLottery( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   LotteryData *lottery = (LotteryData *) malloc(sizeof(LotteryData));
+   int index;
+
+   lottery->readyTickets = createFenwickTree(numProcesses);
+   lottery->processes = (ProcessControlBlock **)
+                         malloc(sizeof(ProcessControlBlock *) * (numProcesses + 1));
+   for(index = 0; index <= numProcesses; index++)
+   {
+      lottery->processes[ index ] = NULL;
+   }
+   lottery->randomState = LOTTERY_SEED;
+
+   processQueue->readyData = lottery;
+}
+
+/*
+Function Name: clearLottery
+Algorithm: releases ticket tree, process table, and lottery data
+Precondition: given process queue
+Postcondition: lottery memory freed, ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearLottery( ProcessQueue *processQueue )
+{
+   LotteryData *lottery = (LotteryData *) processQueue->readyData;
+
+   lottery->readyTickets = clearFenwickTree(lottery->readyTickets);
+   free(lottery->processes);
+   free(lottery);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushLottery
+Algorithm: adds process's tickets to ticket tree at its process ID
+Precondition: given process queue and READY process not holding tickets
+Postcondition: process takes part in draws
+Exceptions: none
+Notes: O(log n)
+*/
+static void pushLottery( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   LotteryData *lottery = (LotteryData *) processQueue->readyData;
+
+   lottery->processes[ pcb->processID ] = pcb;
+   addFenwickValue(lottery->readyTickets, pcb->processID, pcb->tickets);
+}
+
+/*
+Function Name: popLottery
+Algorithm: draws a ticket from all READY tickets, finds its holder in
+           ticket tree, and takes holder's tickets out
+Precondition: given process queue
+Postcondition: returns winning process, or NULL if no process is READY
+Exceptions: none
+Notes: each process wins in proportion to its tickets, O(log n)
+*/
+static ProcessControlBlock *popLottery( ProcessQueue *processQueue )
+{
+   LotteryData *lottery = (LotteryData *) processQueue->readyData;
+   ProcessControlBlock *winner;
+   long winningTicket;
+
+   if(lottery->readyTickets->total <= 0)
+   {
+      return NULL;
+   }
+
+   winningTicket = (long)(nextRandom(lottery) 
+                             % (uint64_t)lottery->readyTickets->total);
+   winner = lottery->processes[ findFenwickIndex(lottery->readyTickets,
+                                                          winningTicket) ];
+   addFenwickValue(lottery->readyTickets, winner->processID, -winner->tickets);
+
+   return winner;
+}
+
+/*
+Function Name: initStride
+Algorithm: creates pass value heap with room for every process
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds stride data
+Exceptions: none
+Notes: none
+*/
+static void initStride( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   StrideData *stride = (StrideData *) malloc(sizeof(StrideData));
+
+   stride->passQueue = createMinHeap(numProcesses);
+   stride->minPass = 0;
+
+   processQueue->readyData = stride;
+}
+
+/*
+Function Name: clearStride
+Algorithm: releases heap and stride data
+Precondition: given process queue
+Postcondition: stride memory freed, ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearStride( ProcessQueue *processQueue )
+{
+   StrideData *stride = (StrideData *) processQueue->readyData;
+
+   stride->passQueue = clearMinHeap(stride->passQueue);
+   free(stride);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushStride
+Algorithm: inserts process keyed by pass value, then process ID
+Precondition: given process queue and READY process not in heap
+Postcondition: process is in heap
+Exceptions: none
+Notes: O(log n)
+*/
+static void pushStride( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   StrideData *stride = (StrideData *) processQueue->readyData;
+
+   insertHeapItem(stride->passQueue, pcb->passValue, pcb->processID,
+                                                     pcb, &pcb->readyIndex);
+}
+
+/*
+Function Name: popStride
+Algorithm: removes process with least pass value, moves least pass up to it
+Precondition: given process queue
+Postcondition: returns that process, or NULL if heap is empty
+Exceptions: none
+Notes: O(log n)
+*/
+static ProcessControlBlock *popStride( ProcessQueue *processQueue )
+{
+   StrideData *stride = (StrideData *) processQueue->readyData;
+   ProcessControlBlock *nextProcess =
+                   (ProcessControlBlock *) popHeapItem(stride->passQueue);
+
+   if(nextProcess != NULL && nextProcess->passValue > stride->minPass)
+   {
+      stride->minPass = nextProcess->passValue;
+   }
+   return nextProcess;
+}
+
+/*
+Function Name: tickStride
+Algorithm: advances pass value by process's stride for each cycle run
+Precondition: given process queue, running process, and cycles it just ran
+Postcondition: pass value is updated
+Exceptions: none
+Notes: stride is inverse of tickets, so more tickets means more turns
+*/
+static void tickStride( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                               int cyclesRun )
+{
+   pcb->passValue += (STRIDE_ONE / pcb->tickets) * cyclesRun;
+}
+
+/*
+Function Name: wakeStride
+Algorithm: raises pass value of process back from I/O to least pass
+           dispatched
+Precondition: given process queue and process whose I/O has ended
+Postcondition: process cannot claim CPU for time spent waiting
+Exceptions: none
+Notes: none
+*/
+static void wakeStride( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   StrideData *stride = (StrideData *) processQueue->readyData;
+
+   if(pcb->passValue < stride->minPass)
+   {
+      pcb->passValue = stride->minPass;
+   }
+}
+
+/*
+Function Name: getDeadlineKey
+Algorithm: reads absolute deadline, none sorts after every deadline
+Precondition: given process
+Postcondition: returns EDF ordering key of process
+Exceptions: none
+Notes: none
+*/
+static SimTime getDeadlineKey( ProcessControlBlock *pcb )
+{
+   if(pcb->absoluteDeadline == 0)
+   {
+      return NO_DEADLINE_KEY;
+   }
+   return pcb->absoluteDeadline;
+}
+
+/*
+Function Name: initEdf
+Algorithm: creates deadline heap with room for every process
+Precondition: given process queue, number of processes, and config data
+Postcondition: ready data holds EDF data, no CPU share is reserved
+Exceptions: none
+Notes: none
+*/
+static void initEdf( ProcessQueue *processQueue, int numProcesses,
+                                                   ConfigDataType *configPtr )
+{
+   EdfData *edf = (EdfData *) malloc(sizeof(EdfData));
+
+   edf->deadlineQueue = createMinHeap(numProcesses);
+   edf->reservedShare = 0;
+   edf->arrivalCount = 0;
+
+   processQueue->readyData = edf;
+}
+
+/*
+Function Name: clearEdf
+Algorithm: releases heap and EDF data
+Precondition: given process queue
+Postcondition: EDF memory freed, ready data is NULL
+Exceptions: none
+Notes: processes themselves belong to the process queue
+*/
+static void clearEdf( ProcessQueue *processQueue )
+{
+   EdfData *edf = (EdfData *) processQueue->readyData;
+
+   edf->deadlineQueue = clearMinHeap(edf->deadlineQueue);
+   free(edf);
+   processQueue->readyData = NULL;
+}
+
+/*
+Function Name: pushEdf
+Algorithm: inserts process keyed by absolute deadline, then arrival
+Precondition: given process queue and READY process not in heap
+Postcondition: process is in heap
+Exceptions: none
+Notes: processes without deadline take turns first come first served
+       behind every deadline; O(log n)
+*/
+static void pushEdf( ProcessQueue *processQueue, ProcessControlBlock *pcb )
+{
+   EdfData *edf = (EdfData *) processQueue->readyData;
+
+   insertHeapItem(edf->deadlineQueue, getDeadlineKey(pcb),
+                           edf->arrivalCount++, pcb, &pcb->readyIndex);
+}
+
+/*
+Function Name: popEdf
+Algorithm: removes process with earliest deadline
+Precondition: given process queue
+Postcondition: returns that process, or NULL if heap is empty
+Exceptions: none
+Notes: O(log n)
+*/
+static ProcessControlBlock *popEdf( ProcessQueue *processQueue )
+{
+   EdfData *edf = (EdfData *) processQueue->readyData;
+
+   return (ProcessControlBlock *) popHeapItem(edf->deadlineQueue);
+}
+
+/*
+Function Name: admitEdf
+Algorithm: finds CPU time of every cpu op left in process, as share of
+           its relative deadline, and reserves that share if it fits
+           alongside shares already held
+Precondition: given process queue, NEW process, and config data
+Postcondition: returns ADMIT_PROCESS with share reserved,
+               DEFER_PROCESS if share does not fit yet, or
+               REFUSE_PROCESS if share alone is more than whole CPU
+Exceptions: process without deadline is always admitted and holds nothing
+Notes: one shot jobs all meet their deadlines under EDF when shares
+       sum to no more than whole CPU; I/O time does not use the CPU,
+       so it is left out
+*/
+static int admitEdf( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                    ConfigDataType *configPtr )
+{
+   EdfData *edf = (EdfData *) processQueue->readyData;
+   OpCodeType *opPtr = pcb->nextOpCommand;
+   SimTime cpuTime = 0;
+   SimTime share;
+
+   if(pcb->relativeDeadline <= 0)
+   {
+      return ADMIT_PROCESS;
+   }
+
+   while(opPtr != NULL && !(compareString(opPtr->command, "app") == STR_EQ
+                      && compareString(opPtr->strArg1, "end") == STR_EQ))
+   {
+      if(compareString(opPtr->command, "cpu") == STR_EQ)
+      {
+         cpuTime += getCommandTime(opPtr, configPtr);
+      }
+      opPtr = opPtr->nextNode;
+   }
+
+   //round up, so a share that just fits is never counted short
+   share = (cpuTime * WHOLE_CPU_SHARE + pcb->relativeDeadline - 1)
+                                                     / pcb->relativeDeadline;
+   if(share > WHOLE_CPU_SHARE)
+   {
+      return REFUSE_PROCESS;
+   }
+   if(edf->reservedShare + share > WHOLE_CPU_SHARE)
+   {
+      return DEFER_PROCESS;
+   }
+
+   edf->reservedShare += share;
+   pcb->cpuReservation = share;
+   return ADMIT_PROCESS;
+}
+
+/*
+Function Name: releaseEdfShare
+Algorithm: gives back CPU share reserved for exiting process
+Precondition: given process queue and exiting process
+Postcondition: process holds no share
+Exceptions: none
+Notes: a deferred process may fit once this returns
+*/
+static void releaseEdfShare( ProcessQueue *processQueue,
+                                               ProcessControlBlock *pcb )
+{
+   EdfData *edf = (EdfData *) processQueue->readyData;
+
+   edf->reservedShare -= pcb->cpuReservation;
+   pcb->cpuReservation = 0;
+}
+
+/*
+Function Name: getEdfQuantum
+Algorithm: gives deadline process no quantum, others configured quantum
+Precondition: given process queue, running process, and config data
+Postcondition: returns quantum cycles
+Exceptions: none
+Notes: deadline process only gives up CPU for an earlier deadline, so
+       its slice never ends on a quantum
+*/
+static int getEdfQuantum( ProcessQueue *processQueue,
+                       ProcessControlBlock *pcb, ConfigDataType *configPtr )
+{
+   if(pcb->absoluteDeadline != 0)
+   {
+      return INT_MAX;
+   }
+   return configPtr->quantumCycles;
+}
+
+/*
+Function Name: preemptIfEarlier
+Algorithm: compares deadlines of woken and running processes
+Precondition: given process queue, running process, and woken process
+Postcondition: returns true if woken process has earlier deadline
+Exceptions: none
+Notes: process without deadline never takes CPU from one with a deadline
+*/
+static Boolean preemptIfEarlier( ProcessQueue *processQueue,
+                                          ProcessControlBlock *running,
+                                          ProcessControlBlock *woken )
+{
+   return getDeadlineKey(woken) < getDeadlineKey(running);
+}
+
+//policy registry, one entry per scheduling code
+static const SchedPolicy SCHED_POLICIES[] =
+   {
+      { "sjf-n", "SJF-N", CPU_SCHED_SJF_N_CODE, False, False,
+        initShortestHeap, clearShortestHeap, pushShortestHeap, popShortestHeap,
+        NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+
+      { "srtf-p", "SRTF-P", CPU_SCHED_SRTF_P_CODE, True, False,
+        initShortestHeap, clearShortestHeap, pushShortestHeap, popShortestHeap,
+        NULL, NULL, NULL, NULL, NULL, getConfigQuantum, preemptAlways },
+
+      { "fcfs-p", "FCFS-P", CPU_SCHED_FCFS_P_CODE, True, False,
+        initReadyRing, clearReadyRing, pushReadyRing, popReadyRing,
+        NULL, NULL, NULL, NULL, NULL, getConfigQuantum, preemptAlways },
+
+      { "rr-p", "RR-P", CPU_SCHED_RR_P_CODE, True, False,
+        initReadyRing, clearReadyRing, pushReadyRing, popReadyRing,
+        NULL, NULL, NULL, NULL, NULL, getConfigQuantum, preemptAlways },
+
+      { "fcfs-n", "FCFS-N", CPU_SCHED_FCFS_N_CODE, False, False,
+        initReadyRing, clearReadyRing, pushReadyRing, popReadyRing,
+        NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+
+      { "mlfq-p", "MLFQ-P", CPU_SCHED_MLFQ_P_CODE, True, False,
+        initMlfq, clearMlfq, pushMlfq, popMlfq,
+        tickMlfq, NULL, NULL, NULL, NULL, getMlfqQuantum, preemptIfHigher },
+
+      { "cfs-p", "CFS-P", CPU_SCHED_CFS_P_CODE, True, False,
+        initCfs, clearCfs, pushCfs, popCfs,
+        tickCfs, NULL, wakeCfs, NULL, NULL, getCfsSlice, preemptIfBehind },
+
+      { "lottery-p", "LOTTERY-P", CPU_SCHED_LOTTERY_P_CODE, True, True,
+        initLottery, clearLottery, pushLottery, popLottery,
+        NULL, NULL, NULL, NULL, NULL, getConfigQuantum, preemptNever },
+
+      { "stride-p", "STRIDE-P", CPU_SCHED_STRIDE_P_CODE, True, True,
+        initStride, clearStride, pushStride, popStride,
+        tickStride, NULL, wakeStride, NULL, NULL, getConfigQuantum,
+        preemptNever },
+
+      { "edf-p", "EDF-P", CPU_SCHED_EDF_P_CODE, True, False,
+        initEdf, clearEdf, pushEdf, popEdf,
+        NULL, NULL, NULL, releaseEdfShare, admitEdf, getEdfQuantum,
+        preemptIfEarlier }
+   };
+
+static const int NUM_SCHED_POLICIES
+                   = sizeof(SCHED_POLICIES) / sizeof(SCHED_POLICIES[ 0 ]);
+
+/*
+Function Name: findSchedPolicy
+Algorithm: compares lower case name against each registered policy
+Precondition: given scheduling name from config file
+Postcondition: returns matching policy, or NULL if none matches
+Exceptions: none
+Notes: name is not case sensitive
+*/
+const SchedPolicy *findSchedPolicy( char *name )
+{
+   char tempStr[ MAX_STR_LEN ];
+   int index;
+
+   if(getStringLength(name) >= MAX_STR_LEN)
+   {
+      return NULL;
+   }
+   setStrToLowerCase(tempStr, name);
+
+   for(index = 0; index < NUM_SCHED_POLICIES; index++)
+   {
+      if(compareString(tempStr, (char *) SCHED_POLICIES[ index ].name)
+                                                                 == STR_EQ)
+      {
+         return &SCHED_POLICIES[ index ];
+      }
+   }
+   return NULL;
+}
+
+/*
+Function Name: getSchedPolicy
+Algorithm: finds registered policy with given code
+Precondition: given scheduling code from config data
+Postcondition: returns matching policy, FCFS-N if none matches
+Exceptions: unknown code falls back to FCFS-N, as config upload does
+Notes: none
+*/
+const SchedPolicy *getSchedPolicy( int schedCode )
+{
+   int index;
+
+   for(index = 0; index < NUM_SCHED_POLICIES; index++)
+   {
+      if(SCHED_POLICIES[ index ].schedCode == schedCode)
+      {
+         return &SCHED_POLICIES[ index ];
+      }
+   }
+   return getSchedPolicy(CPU_SCHED_FCFS_N_CODE);
+}
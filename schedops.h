@@ -0,0 +1,116 @@
+//pre-compiler directive
+#ifndef SCHEDOPS_H
+#define SCHEDOPS_H
+
+//header files
+#include "datatypes.h"
+#include "processops.h"
+#include "treeops.h"
+#include "heapops.h"
+#include "fenwickops.h"
+
+//constants
+#define MLFQ_LEVELS 3
+
+//types
+typedef enum { ADMIT_PROCESS,
+               DEFER_PROCESS,
+               REFUSE_PROCESS } admissionCodes;
+
+typedef struct SchedPolicy
+   {
+      const char *name;         //name used in config file, lower case
+      const char *displayName;  //name shown in config display
+      int schedCode;            //code stored in config data
+      Boolean preemptive;       //I/O runs alongside CPU and can interrupt it,
+                                // running process is checked for quantum
+      Boolean reportsShares;    //CPU share of each process against its
+                                // tickets is reported at end of run
+
+      //required: set up and release policy's ready structure
+      void (*init)( ProcessQueue *processQueue, int numProcesses,
+                                             ConfigDataType *configPtr );
+      void (*clear)( ProcessQueue *processQueue );
+
+      //required: add READY process, take next process to run or NULL
+      void (*enqueue)( ProcessQueue *processQueue, ProcessControlBlock *pcb );
+      ProcessControlBlock *(*dequeueNext)( ProcessQueue *processQueue );
+
+      //optional: told of cycles run, of moves to WAITING, of I/O ends,
+      // and of exits
+      void (*onTick)( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                             int cyclesRun );
+      void (*onBlock)( ProcessQueue *processQueue, ProcessControlBlock *pcb );
+      void (*onWake)( ProcessQueue *processQueue, ProcessControlBlock *pcb );
+      void (*onExit)( ProcessQueue *processQueue, ProcessControlBlock *pcb );
+
+      //optional: whether NEW process may become READY, as admissionCodes
+      int (*admit)( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                    ConfigDataType *configPtr );
+
+      //preemptive only: cycles running process may hold CPU for, and
+      // whether process whose I/O just ended takes CPU from it
+      int (*getQuantum)( ProcessQueue *processQueue, ProcessControlBlock *pcb,
+                                                    ConfigDataType *configPtr );
+      Boolean (*shouldPreempt)( ProcessQueue *processQueue,
+                                            ProcessControlBlock *running,
+                                            ProcessControlBlock *woken );
+   } SchedPolicy;
+
+typedef struct ShortestData
+   {
+      MinHeap *timeQueue;       //READY processes by time left
+      Boolean predictBursts;    //rank by predicted burst left, not exact
+                                // time remaining
+      int cycleRate;            //ms per CPU cycle
+   } ShortestData;
+
+typedef struct MlfqData
+   {
+      ProcessControlBlock *levelRings[ MLFQ_LEVELS ]; //oldest READY
+                                            // process of each level
+      int baseQuantum;          //quantum of top level, doubles per level
+      long boostCycles;         //cycles run between priority boosts
+      long cyclesSinceBoost;    //cycles run since last boost
+      long boostEpoch;          //number of boosts so far
+   } MlfqData;
+
+typedef struct CfsData
+   {
+      OrderedTree *timeline;    //READY processes by virtual runtime
+      SimTime minRuntime;       //least virtual runtime dispatched, never
+                                // goes down
+      long readyWeight;         //total weight of READY processes
+      int latencyCycles;        //target latency, split among runnable
+                                // processes by weight
+      int minSliceCycles;       //shortest slice given out
+   } CfsData;
+
+typedef struct LotteryData
+   {
+      FenwickTree *readyTickets;  //tickets of READY processes, by process ID
+      ProcessControlBlock **processes; //process with each ID
+      uint64_t randomState;       //draw generator state, same seed every run
+   } LotteryData;
+
+typedef struct StrideData
+   {
+      MinHeap *passQueue;       //READY processes by pass value
+      SimTime minPass;          //least pass value dispatched, never goes down
+   } StrideData;
+
+typedef struct EdfData
+   {
+      MinHeap *deadlineQueue;   //READY processes by absolute deadline,
+                                // those without one last
+      long reservedShare;       //CPU share held by admitted deadline
+                                // processes, in millionths
+      long arrivalCount;        //times a process was made READY, orders
+                                // equal deadlines first come first served
+   } EdfData;
+
+//function headers
+const SchedPolicy *findSchedPolicy( char *name );
+const SchedPolicy *getSchedPolicy( int schedCode );
+
+#endif //SCHEDOPS_H
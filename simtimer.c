@@ -21,6 +21,9 @@
 #ifndef SIMTIMER_C
 #define SIMTIMER_C
 
+// needed for clock_nanosleep and CLOCK_MONOTONIC under -std=c99
+#define _POSIX_C_SOURCE 200112L
+
 // Header files ///////////////////////////////////////////////////////////////
 
 #include "simtimer.h"
@@ -29,205 +32,406 @@
 
 const char RADIX_POINT = '.';
 
-void * runTimer( void * mS )
-   {
-     int *mSPtr = (int*)mS;
-     int milliSeconds = *mSPtr;
-
-    struct timeval startTime, endTime;
-    int startSec, startUSec, endSec, endUSec;
-    int uSecDiff, mSecDiff, secDiff, timeDiff;
+// Deadline waits sleep until this long before the deadline, then spin
+//    the rest of the way to absorb scheduler wake-up latency
+static const SimTime FINAL_SPIN_NSEC = 200000;
 
-    gettimeofday( &startTime, NULL );
- 
-    startSec = startTime.tv_sec;
-    startUSec = startTime.tv_usec;
+const SimTime NSEC_PER_SEC = 1000000000;
+const SimTime NSEC_PER_MSEC = 1000000;
+const SimTime NSEC_PER_USEC = 1000;
 
-    timeDiff = 0;
+static void * runClockThread( void * clockPtr );
 
-    while( timeDiff < milliSeconds )
+/*
+Function Name: createSimClock
+Algorithm: allocates and initializes a clock for one simulation run;
+           on wall clock time also starts the clock thread
+Precondition: modeCode is WALL_CLOCK_TIMER or VIRTUAL_TIMER
+Postcondition: returns new clock, not yet running until ZERO_TIMER
+Exceptions: waits run in the calling thread if the clock thread
+            cannot be created
+Notes: in virtual mode no time passes unless waitTimer or jumpTimer is called
+*/
+SimClock *createSimClock( int modeCode )
+   {
+    SimClock *simClock = (SimClock *) malloc( sizeof( SimClock ) );
+
+    simClock->timerMode = modeCode;
+    simClock->running = False;
+    simClock->startNSec = 0;
+    simClock->virtualNSec = 0;
+    simClock->runDeadline = 0;
+
+    pthread_mutex_init( &simClock->clockLock, NULL );
+    pthread_cond_init( &simClock->requestCond, NULL );
+    pthread_cond_init( &simClock->doneCond, NULL );
+    simClock->threadRunning = False;
+
+    simClock->requestPending = False;
+    simClock->shutdown = False;
+    simClock->requestDeadline = 0;
+
+    if( modeCode == WALL_CLOCK_TIMER
+        && pthread_create( &simClock->clockThread, NULL,
+                                   runClockThread, (void *) simClock ) == 0 )
        {
-        gettimeofday( &endTime, NULL );
+        simClock->threadRunning = True;
+       }
 
-        endSec = endTime.tv_sec;
-        endUSec = endTime.tv_usec;
-        uSecDiff = endUSec - startUSec;
+    return simClock;
+   }
 
-        if( uSecDiff < 0 )
+/*
+Function Name: clearSimClock
+Algorithm: stops and joins the clock thread if running,
+           then releases the clock
+Precondition: clock created by createSimClock, or null
+Postcondition: clock memory is returned to OS, null is returned
+Exceptions: none
+Notes: none
+*/
+SimClock *clearSimClock( SimClock *simClock )
+   {
+    if( simClock != NULL )
+       {
+        if( simClock->threadRunning == True )
            {
-            uSecDiff = uSecDiff + 1000000;
+            pthread_mutex_lock( &simClock->clockLock );
+            simClock->shutdown = True;
+            pthread_cond_signal( &simClock->requestCond );
+            pthread_mutex_unlock( &simClock->clockLock );
 
-            endSec = endSec - 1;
+            pthread_join( simClock->clockThread, NULL );
            }
 
-        mSecDiff = uSecDiff / 1000;
-        secDiff = ( endSec - startSec ) * 1000;
-        timeDiff = secDiff + mSecDiff;
+        pthread_cond_destroy( &simClock->doneCond );
+        pthread_cond_destroy( &simClock->requestCond );
+        pthread_mutex_destroy( &simClock->clockLock );
+
+        free( simClock );
        }
 
-      return NULL;
+    return NULL;
    }
 
+/*
+Function Name: getMonotonicTime
+Algorithm: reads CLOCK_MONOTONIC
+Precondition: none
+Postcondition: returns current monotonic time in nanoseconds
+Exceptions: none
+Notes: not affected by wall clock adjustments
+*/
+SimTime getMonotonicTime()
+   {
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
 
+    return (SimTime) now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+   }
 
-double accessTimer( int controlCode, char *timeStr )
+/*
+Function Name: waitUntilDeadline
+Algorithm: sleeps on CLOCK_MONOTONIC until shortly before the absolute
+           deadline, then spins until the deadline has passed
+Precondition: deadline is a monotonic time in nanoseconds
+Postcondition: returns at or just after the deadline
+Exceptions: returns at once if the deadline has already passed
+Notes: uses almost no CPU while waiting, only the final spin is busy
+*/
+static void waitUntilDeadline( SimTime deadline )
    {
-    static Boolean running = False;
-    static int startSec = 0, endSec = 0, startUSec = 0, endUSec = 0;
-    static int lapSec = 0, lapUSec = 0;
-    struct timeval startData, lapData, endData;
-    double fpTime = 0.0;
+    struct timespec sleepUntil;
+    SimTime sleepNSec = deadline - FINAL_SPIN_NSEC;
 
-    switch( controlCode )
+    sleepUntil.tv_sec = (time_t) ( sleepNSec / NSEC_PER_SEC );
+    sleepUntil.tv_nsec = (long) ( sleepNSec % NSEC_PER_SEC );
+
+    // sleep, restarting if interrupted by a signal
+    while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                               &sleepUntil, NULL ) == EINTR )
        {
-        case ZERO_TIMER:
-           gettimeofday( &startData, NULL );
-           running = True;
+       }
 
-           startSec = startData.tv_sec;
-           startUSec = startData.tv_usec;
+    // spin the remaining distance
+    while( getMonotonicTime() < deadline )
+       {
+       }
+   }
 
-           fpTime = 0.000000000;
-           lapSec = 0.000000000;
-           lapUSec = 0.000000000;
+/*
+Function Name: runClockThread
+Algorithm: body of the long-lived clock thread; sleeps until a deadline is
+           handed over, waits for it, then signals completion
+Precondition: started by createSimClock with its clock as argument
+Postcondition: returns once clearSimClock requests shutdown
+Exceptions: none
+Notes: none
+*/
+static void * runClockThread( void * clockPtr )
+   {
+    SimClock *simClock = (SimClock *) clockPtr;
+    SimTime deadline;
 
-           timeToString( lapSec, lapUSec, timeStr ); 
-           break;
-           
-        case LAP_TIMER:
-           if( running == True )
-              {
-               gettimeofday( &lapData, NULL );
+    pthread_mutex_lock( &simClock->clockLock );
 
-               lapSec = lapData.tv_sec;
-               lapUSec = lapData.tv_usec;
+    while( simClock->shutdown == False )
+       {
+        if( simClock->requestPending == True )
+           {
+            deadline = simClock->requestDeadline;
 
-               fpTime = processTime( startSec, lapSec, 
-                                                 startUSec, lapUSec, timeStr );
-              }
+            // run the wait without holding the lock
+            pthread_mutex_unlock( &simClock->clockLock );
+            waitUntilDeadline( deadline );
+            pthread_mutex_lock( &simClock->clockLock );
 
-           else
-              {
-               fpTime = 0.000000000;
-              }
-           break;
+            simClock->requestPending = False;
+            pthread_cond_signal( &simClock->doneCond );
+           }
 
-        case STOP_TIMER:
-           if( running == True )
-              {
-               gettimeofday( &endData, NULL );
-               running = False;
+        else
+           {
+            pthread_cond_wait( &simClock->requestCond,
+                                                     &simClock->clockLock );
+           }
+       }
 
-               endSec = endData.tv_sec;
-               endUSec = endData.tv_usec;
+    pthread_mutex_unlock( &simClock->clockLock );
 
-               fpTime = processTime( startSec, endSec, 
-                                                 startUSec, endUSec, timeStr );
-              }
+    return NULL;
+   }
 
-           // assume timer not running
-           else
-              {
-               fpTime = 0.000000000;
-              }
-           break;
+/*
+Function Name: startTimerRun
+Algorithm: anchors the following waitTimer calls at the current time
+Precondition: clock created by createSimClock
+Postcondition: next waitTimer deadline is measured from now
+Exceptions: no effect in virtual mode, where waits never overshoot
+Notes: call once before a run of cycles, not before every cycle
+*/
+void startTimerRun( SimClock *simClock )
+   {
+    if( simClock->timerMode == WALL_CLOCK_TIMER )
+       {
+        simClock->runDeadline = getMonotonicTime();
        }
-
-    return fpTime;
    }
 
-double processTime( double startSec, double endSec, 
-                           double startUSec, double endUSec, char *timeStr )
+/*
+Function Name: getRunDeadline
+Algorithm: reads time the current run of waits is scheduled up to
+Precondition: clock created by createSimClock, timer zeroed
+Postcondition: returns deadline of last wait as time since zero
+Exceptions: none
+Notes: on virtual time this is the clock itself; on wall clock time it
+       leaves out any overshoot of the real wait, so it is the same on
+       every run
+*/
+SimTime getRunDeadline( SimClock *simClock )
    {
-    double secDiff = endSec - startSec;
-    double uSecDiff = endUSec - startUSec;
-    double fpTime;
+    if( simClock->timerMode == VIRTUAL_TIMER )
+       {
+        return simClock->virtualNSec;
+       }
 
-    fpTime = (double) secDiff + (double) uSecDiff / 1000000;
+    return simClock->runDeadline - simClock->startNSec;
+   }
 
-    if( uSecDiff < 0 )
+/*
+Function Name: waitTimer
+Algorithm: lets the given number of milliseconds pass; on wall clock time
+           moves the run deadline forward and sleeps until the clock thread
+           reports the deadline reached, on virtual time moves the virtual
+           clock forward without waiting
+Precondition: milliSeconds >= 0, startTimerRun called at start of the run
+Postcondition: timer reads milliSeconds past the previous deadline
+Exceptions: waits in the calling thread if the clock thread is not running
+Notes: deadlines are absolute, so overshoot of one wait is not carried
+       into the next
+*/
+void waitTimer( SimClock *simClock, int milliSeconds )
+   {
+    if( simClock->timerMode == VIRTUAL_TIMER )
        {
-        uSecDiff = uSecDiff + 1000000;
-        secDiff = secDiff - 1;
+        simClock->virtualNSec = simClock->virtualNSec
+                                             + milliSeconds * NSEC_PER_MSEC;
        }
 
-    timeToString( secDiff, uSecDiff, timeStr );
+    else
+       {
+        simClock->runDeadline = simClock->runDeadline
+                                             + milliSeconds * NSEC_PER_MSEC;
+
+        if( simClock->threadRunning == True )
+           {
+            pthread_mutex_lock( &simClock->clockLock );
+
+            simClock->requestDeadline = simClock->runDeadline;
+            simClock->requestPending = True;
+            pthread_cond_signal( &simClock->requestCond );
 
-    return fpTime;
+            while( simClock->requestPending == True )
+               {
+                pthread_cond_wait( &simClock->doneCond,
+                                                     &simClock->clockLock );
+               }
+
+            pthread_mutex_unlock( &simClock->clockLock );
+           }
+
+        else
+           {
+            waitUntilDeadline( simClock->runDeadline );
+           }
+       }
    }
 
+/*
+Function Name: jumpTimer
+Algorithm: moves virtual clock forward to the given time
+Precondition: clock is in virtual mode, targetTime is time since zero
+Postcondition: virtual clock is at targetTime, never moved backward
+Exceptions: ignored on wall clock time
+Notes: used to skip idle periods straight to the next event
+*/
+void jumpTimer( SimClock *simClock, SimTime targetTime )
+   {
+    if( simClock->timerMode == VIRTUAL_TIMER
+        && targetTime > simClock->virtualNSec )
+       {
+        simClock->virtualNSec = targetTime;
+       }
+   }
 
-/* This is a bit of a drawn-out function, but it is written
-   to force the time result to always be in the form x.xxxxxxx
-   when printed as a string; this will not always be the case
-   if the time is presented as a floating point number
+/*
+Function Name: idleTimer
+Algorithm: on wall clock time sleeps until the given time; on virtual
+           time jumps straight to it
+Precondition: clock created by createSimClock, timer zeroed,
+              wakeTime is time since zero
+Postcondition: timer reads at least wakeTime
+Exceptions: returns at once if wakeTime has already passed
+Notes: the calling thread sleeps in the kernel, so an idle simulated CPU
+       uses no host CPU; no final spin, idle wake-up is not on a deadline
+       the log depends on
 */
-void timeToString( int secTime, int uSecTime, char *timeStr )
+void idleTimer( SimClock *simClock, SimTime wakeTime )
    {
-    int low, high, index = 0;
-    char temp;
+    struct timespec wakeSpec;
+    SimTime absoluteWake;
 
-    while( uSecTime > 0 )
+    if( simClock->timerMode == VIRTUAL_TIMER )
        {
-        timeStr[ index ] = (char) ( uSecTime % 10 + '0' );
-        uSecTime /= 10;
-
-        index++;
-        
+        jumpTimer( simClock, wakeTime );
+        return;
        }
 
-    while( index < 6 )
-       {
-        timeStr[ index ] = '0';
+    absoluteWake = simClock->startNSec + wakeTime;
+    wakeSpec.tv_sec = (time_t)( absoluteWake / NSEC_PER_SEC );
+    wakeSpec.tv_nsec = (long)( absoluteWake % NSEC_PER_SEC );
 
-        index++;
+    // sleep, restarting if interrupted by a signal
+    while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME,
+                                               &wakeSpec, NULL ) == EINTR )
+       {
        }
+   }
 
-    timeStr[ index ] = RADIX_POINT;
-
-    index++;
+SimTime accessTimer( SimClock *simClock, int controlCode )
+   {
+    SimTime lapTime = 0;
 
-    if( secTime < 10 ) // single digit in display
+    if( simClock->timerMode == VIRTUAL_TIMER )
        {
-        timeStr[ index ] = (char) ( secTime % 10 + '0' );
+        if( controlCode == ZERO_TIMER )
+           {
+            simClock->virtualNSec = 0;
+           }
 
-        index++;
+        return simClock->virtualNSec;
+       }
 
-        timeStr[ index ] = SPACE;
+    switch( controlCode )
+       {
+        case ZERO_TIMER:
+           simClock->startNSec = getMonotonicTime();
+           simClock->running = True;
+           break;
+           
+        case LAP_TIMER:
+           if( simClock->running == True )
+              {
+               lapTime = getMonotonicTime() - simClock->startNSec;
+              }
+           break;
 
-        index++;
+        case STOP_TIMER:
+           if( simClock->running == True )
+              {
+               simClock->running = False;
 
-        secTime = 0;
+               lapTime = getMonotonicTime() - simClock->startNSec;
+              }
+           break;
        }
+
+    return lapTime;
+   }
+
 /*
-    if( secTime == 0 )
-       {
-        timeStr[ index ] = '0';
-    
-        index++;
-       }
+Function Name: timeToString
+Algorithm: writes time as whole seconds, radix point, and six digits
+           of microseconds, e.g., 12.034567
+Precondition: time >= 0, timeStr has room for the digits
+Postcondition: timeStr holds formatted time, its length is returned
+Exceptions: none
+Notes: integer arithmetic only, so long runs lose no precision;
+       digits are written directly, without sprintf
 */
-    while( secTime > 0 )
+int timeToString( SimTime time, char *timeStr )
+   {
+    char secDigits[ 20 ];
+    SimTime seconds = time / NSEC_PER_SEC;
+    SimTime uSeconds = time % NSEC_PER_SEC / NSEC_PER_USEC;
+    int numDigits = 0, index = 0, place;
+
+    // collect seconds digits, lowest first
+    do
        {
-        timeStr[ index ] = (char) ( secTime % 10 + '0' );
+        secDigits[ numDigits ] = (char) ( seconds % 10 + '0' );
+        seconds /= 10;
+
+        numDigits++;
+       }
+    while( seconds > 0 );
 
-        secTime /= 10;
+    // write seconds digits, highest first
+    while( numDigits > 0 )
+       {
+        numDigits--;
+        timeStr[ index ] = secDigits[ numDigits ];
 
         index++;
        }
 
-    timeStr[ index ] = NULL_CHAR;
+    timeStr[ index ] = RADIX_POINT;
 
-    low = 0; high = index - 1;
+    index++;
 
-    while( low < high )
+    // write microseconds with leading zeros, lowest digit last
+    for( place = 5; place >= 0; place-- )
        {
-        temp = timeStr[ low ];
-        timeStr[ low ] = timeStr[ high ];
-        timeStr[ high ] = temp;
-
-        low++; high--;
+        timeStr[ index + place ] = (char) ( uSeconds % 10 + '0' );
+        uSeconds /= 10;
        }
+
+    index = index + 6;
+
+    timeStr[ index ] = NULL_CHAR;
+
+    return index;
    }
 
 #endif // ifndef SIMTIMER_C
@@ -22,24 +22,60 @@
 // Header files ///////////////////////////////////////////////////////////////
 
 #include <sys/time.h>
+#include <time.h>
+#include <errno.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 #include "StringUtils.h"
 
 // Global Constants  //////////////////////////////////////////////////////////
 
 enum TIMER_CTRL_CODES { ZERO_TIMER, LAP_TIMER, STOP_TIMER };
 
+enum TIMER_MODE_CODES { WALL_CLOCK_TIMER, VIRTUAL_TIMER };
+
 extern const char RADIX_POINT;
 extern const char SPACE;
+extern const SimTime NSEC_PER_SEC;
+extern const SimTime NSEC_PER_MSEC;
+extern const SimTime NSEC_PER_USEC;
+
+// Data Types  ////////////////////////////////////////////////////////////////
+
+// One clock per simulation run, so that several runs in one process
+//    do not share timer state
+typedef struct SimClock
+   {
+    int timerMode;               // WALL_CLOCK_TIMER or VIRTUAL_TIMER
+    Boolean running;             // set from ZERO_TIMER until STOP_TIMER
+    SimTime startNSec;           // monotonic reading at ZERO_TIMER
+    SimTime virtualNSec;         // virtual time since ZERO_TIMER
+    SimTime runDeadline;         // monotonic deadline of last wait in run
+
+    pthread_t clockThread;       // long-lived thread that runs the waits
+    pthread_mutex_t clockLock;   // guards the request fields below
+    pthread_cond_t requestCond;  // signalled when a wait is handed over
+    pthread_cond_t doneCond;     // signalled when a wait is finished
+    Boolean threadRunning;       // clock thread was started
+    Boolean requestPending;      // wait handed over and not yet finished
+    Boolean shutdown;            // clock thread asked to end
+    SimTime requestDeadline;     // monotonic deadline handed to the thread
+   } SimClock;
 
 // Function Prototyp  /////////////////////////////////////////////////////////
 
-void * runTimer( void * mS );
-double accessTimer( int controlCode, char *timeStr );
-double processTime( double startSec, double endSec, 
-                           double startUSec, double endUSec, char *timeStr );
-void timeToString( int secTime, int uSecTime, char *timeStr );
+SimClock *createSimClock( int modeCode );
+SimClock *clearSimClock( SimClock *simClock );
+void startTimerRun( SimClock *simClock );
+void waitTimer( SimClock *simClock, int milliSeconds );
+void jumpTimer( SimClock *simClock, SimTime targetTime );
+void idleTimer( SimClock *simClock, SimTime wakeTime );
+SimTime accessTimer( SimClock *simClock, int controlCode );
+SimTime getMonotonicTime();
+SimTime getRunDeadline( SimClock *simClock );
+int timeToString( SimTime time, char *timeStr );
 
 #endif // ifndef SIMTIMER_H
 
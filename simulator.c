@@ -5,6 +5,7 @@
 #include "configops.h"
 #include "outputops.h"
 #include "memops.h"
+#include "schedops.h"
 #include <pthread.h> 
 
 
@@ -17,36 +18,36 @@ Algorithm: master driver for simulator operations;
 Precondition: given head pointer to config data and meta data
 Postcondition: simulation is provided, file output is provided as configured
 Exceptions: none
-Notes: none
+Notes: all timer state lives in a clock created for this run, so several
+       runs may share one process; meta data list is left to the caller
 */
 void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
    {
       //initialize variables
       ProcessControlBlock *currentProcess = NULL;
-      ProcessControlBlock *queueHead = NULL;
+      ProcessQueue *processQueue = NULL;
       outputNode *outputHead = NULL;
+      SimClock *simClock;
       int processStatus;
-      char timeBuffer[STD_STR_LEN];
-      OpCodeType *currentOpCmd = metaDataMstrPtr;
-      ioData *interruptQueueHead = NULL;
+      InterruptQueue *interruptQueue = createInterruptQueue(configPtr);
       char output[MAX_STR_LEN];
-      char intBuffer[STD_STR_LEN];
-      double currentTime;
-      Boolean preemptive;
+      int outputLength;
+      SimTime currentTime;
+      const SimKernel *kernel = 
+                     getSimKernel(getSchedPolicy(configPtr->cpuSchedCode));
       Boolean idlingReported = False; 
       int prevProcessID;
-      if(configPtr->cpuSchedCode == CPU_SCHED_SRTF_P_CODE
-           || configPtr->cpuSchedCode == CPU_SCHED_FCFS_P_CODE
-           || configPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE)
+      //create clock for this run on wall clock or virtual time,
+      // then begin timer
+      if(configPtr->virtualTime == True)
+      {
+         simClock = createSimClock(VIRTUAL_TIMER);
+      }
+      else
       {
-            preemptive = True;
+         simClock = createSimClock(WALL_CLOCK_TIMER);
       }
-     else
-     {
-        preemptive = False;
-     } 
-      //begin timer
-      accessTimer(ZERO_TIMER, timeBuffer);
+      accessTimer(simClock, ZERO_TIMER);
 
 
       //report simulator start 
@@ -54,29 +55,33 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
       printf("-------------\n");
 
      //report system start
-      currentTime = accessTimer(LAP_TIMER, timeBuffer);
-      sprintf(output, "%f", currentTime);
-      concatenateString(output, ",  OS: System start");
+      currentTime = accessTimer(simClock, LAP_TIMER);
+      outputLength = startLogLine(output, currentTime);
+      appendToLine(output, outputLength, " OS: System start");
       outputHead = addToOutputList(outputHead, output, configPtr);
 
       //create process queue
-      queueHead = createProcessQueue(metaDataMstrPtr, configPtr, &outputHead);
+      processQueue = createProcessQueue(metaDataMstrPtr, configPtr, &outputHead,
+                                                                  simClock);
 
  
 
       //get first process
-      processStatus = getNextProcess(queueHead, currentProcess, &currentProcess, configPtr); 
-      //report first process choice
-      currentTime = accessTimer(LAP_TIMER, timeBuffer);
-      sprintf(output, "%f", currentTime);
-      concatenateString(output, ",  OS: Process ");
-      sprintf(intBuffer, "%d", currentProcess->processID);
-      concatenateString(output, intBuffer);
-      concatenateString(output, " selected with ");
-      sprintf(intBuffer, "%d", currentProcess->timeRemaining);
-      concatenateString(output, intBuffer);
-      concatenateString(output, " ms remaining");
-      outputHead = addToOutputList(outputHead, output, configPtr);
+      processStatus = getNextProcess(processQueue, currentProcess, &currentProcess, configPtr); 
+      //report first process choice, none if policy refused them all
+      if(processStatus == PROCESS_AVAILABLE)
+      {
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         outputLength = startLogLine(output, currentTime);
+         outputLength = appendToLine(output, outputLength, " OS: Process ");
+         outputLength = appendIntToLine(output, outputLength, 
+                                                  currentProcess->processID);
+         outputLength = appendToLine(output, outputLength, " selected with ");
+         outputLength = appendIntToLine(output, outputLength, 
+                                              currentProcess->timeRemaining);
+         appendToLine(output, outputLength, " ms remaining");
+         outputHead = addToOutputList(outputHead, output, configPtr);
+      }
 
       //loop until all processes are exiting
       while(processStatus != ALL_PROCESSES_EXITING)
@@ -89,34 +94,42 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
             //get next process
             do
             {
-               processStatus = getNextProcess(queueHead, 
+               processStatus = getNextProcess(processQueue, 
                       currentProcess, &currentProcess, configPtr);
                if(processStatus == ALL_PROCESSES_WAITING && idlingReported== False)
                {
-                  currentTime = accessTimer(LAP_TIMER, timeBuffer);
-                  sprintf(output, "%f", currentTime);
-                  concatenateString(output, 
-                                  ",  OS: CPU idle, all active processes waiting");  
+                  currentTime = accessTimer(simClock, LAP_TIMER);
+                  outputLength = startLogLine(output, currentTime);
+                  appendToLine(output, outputLength,
+                                  " OS: CPU idle, all active processes waiting");  
                   outputHead = addToOutputList(outputHead, output, configPtr);           
                  
 
                   idlingReported=True;
                } 
 
-               if(preemptive == True)
+               //nothing happens until the next I/O ends, so sleep until
+               // then, or move the clock straight to it on virtual time
+               if(processStatus == ALL_PROCESSES_WAITING 
+                     && interruptQueueIsEmpty(interruptQueue) == False)
+               {
+                  idleTimer(simClock, getEarliestInterrupt(interruptQueue));
+               }
+
+               if(kernel->preemptive == True)
                {
                   manageInterrupts(CLEAR_ALL_INTERRUPTS, NULL, 
-                                     &interruptQueueHead, &queueHead,
-                                     &outputHead, configPtr);
+                                     interruptQueue, processQueue,
+                                     &outputHead, configPtr, simClock);
                }
             }while(processStatus == ALL_PROCESSES_WAITING);
             //if cpu was idling, report that CPU stopped idling
             if(idlingReported == True)
             {
-               currentTime = accessTimer(LAP_TIMER, timeBuffer); 
-               sprintf(output, "%f", currentTime);
-               concatenateString(output, 
-                              ",  OS: CPU interrupt, end idle");
+               currentTime = accessTimer(simClock, LAP_TIMER); 
+               outputLength = startLogLine(output, currentTime);
+               appendToLine(output, outputLength, 
+                              " OS: CPU interrupt, end idle");
 
                outputHead = addToOutputList(outputHead, output, configPtr);           
          
@@ -128,131 +141,607 @@ void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr )
             if(processStatus == PROCESS_AVAILABLE && 
                   prevProcessID != currentProcess->processID)
             {  
-               currentTime = accessTimer(LAP_TIMER, timeBuffer);
-               sprintf(output, "%f", currentTime);
-               concatenateString(output, ",  OS: Process ");
-               sprintf(intBuffer, "%d", currentProcess->processID);
-               concatenateString(output, intBuffer);
-               concatenateString(output, " ");
+               currentTime = accessTimer(simClock, LAP_TIMER);
+               outputLength = startLogLine(output, currentTime);
+               outputLength = appendToLine(output, outputLength, " OS: Process ");
+               outputLength = appendIntToLine(output, outputLength,
+                                                  currentProcess->processID);
                //report process state modification to running
                //(done in getNextProcess)
-               concatenateString(output, "selected");	
+               outputLength = appendToLine(output, outputLength, " selected");	
   
-               sprintf(intBuffer, "%d", currentProcess->timeRemaining);
-               concatenateString(output, " with ");
-               concatenateString(output, intBuffer);
-               concatenateString(output, " ms remaining");
+               outputLength = appendToLine(output, outputLength, " with ");
+               outputLength = appendIntToLine(output, outputLength,
+                                              currentProcess->timeRemaining);
+               appendToLine(output, outputLength, " ms remaining");
                outputHead = addToOutputList(outputHead, output, configPtr);           
      
             }
                 
          } 
-         //process current operation
-         outputHead = processLine(outputHead, configPtr, &currentProcess, queueHead,
-                                   &interruptQueueHead);
-         //check for and resolve interrupts if preemptive
-         if(preemptive == True)
+         //process current operation, unless last process has just exited
+         if(processStatus != ALL_PROCESSES_EXITING)
          {
-            manageInterrupts(CLEAR_ALL_INTERRUPTS, NULL, &interruptQueueHead, &queueHead,
-                                     &outputHead, configPtr);
-         }
+            outputHead = processLine(outputHead, configPtr, &currentProcess, 
+                              processQueue, interruptQueue, simClock, kernel);
+
+            //an exit may free what a process held in NEW waits for
+            if(processQueue->stateCounts[ NEW ] > 0 
+                  && currentProcess->processState == EXITING)
+            {
+               admitNewProcesses(processQueue, &outputHead, configPtr, 
+                                                                  simClock);
+            }
+            //check for and resolve interrupts if preemptive
+            if(kernel->preemptive == True)
+            {
+               manageInterrupts(CLEAR_ALL_INTERRUPTS, NULL, interruptQueue, 
+                            processQueue, &outputHead, configPtr, simClock);
+            }
          
-         //move process's next op cmd ptr fwd if we have a valid process
-         // that's still running
-         if(currentProcess != NULL && currentProcess->processState == RUNNING)
-         {
-            currentProcess->nextOpCommand = (currentProcess->nextOpCommand)->nextNode;
+            //move process's next op cmd ptr fwd if we have a valid process
+            // that's still running
+            if(currentProcess != NULL && currentProcess->processState == RUNNING)
+            {
+               currentProcess->nextOpCommand = (currentProcess->nextOpCommand)->nextNode;
+            }
          }
 
       }
       //end loop
 
+      //report how timing wheel expired I/O events, if used
+      if(interruptQueue->wheel != NULL)
+      {
+         reportWheelExpiries(interruptQueue->wheel, &outputHead, configPtr,
+                                                                   simClock);
+      }
+
+      //report how well CPU bursts were predicted, if predicted
+      if(configPtr->burstAlpha > 0)
+      {
+         reportBurstPredictions(processQueue, &outputHead, configPtr,
+                                                                   simClock);
+      }
+
+      //report page faults and TLB use, if paging
+      if(processQueue->pagedMemory != NULL)
+      {
+         reportPaging(processQueue->pagedMemory, &outputHead, configPtr,
+                                                                   simClock);
+      }
+
+      //report how allocator placed blocks, if placing
+      if(processQueue->placement != NULL)
+      {
+         reportPlacement(processQueue->placement, &outputHead, configPtr,
+                                                                   simClock);
+      }
+
+      //report CPU share of each process, if policy shares by tickets
+      if(processQueue->policy->reportsShares == True)
+      {
+         reportCpuShares(processQueue, &outputHead, configPtr, simClock);
+      }
+
       //report system end
-      currentTime = accessTimer(LAP_TIMER, timeBuffer);
-      sprintf(output, "%f", currentTime);
-      concatenateString(output, ",  OS: System stop ");
+      currentTime = accessTimer(simClock, LAP_TIMER);
+      outputLength = startLogLine(output, currentTime);
+      appendToLine(output, outputLength, " OS: System stop ");
 
       outputHead = addToOutputList(outputHead, output, configPtr);
 
 
       //end timer
-      accessTimer(STOP_TIMER, timeBuffer);
+      accessTimer(simClock, STOP_TIMER);
       
       //write operations to file if log to was both or file
       if(configPtr->logToCode == LOGTO_BOTH_CODE || configPtr->logToCode == LOGTO_FILE_CODE)
       {
          writeToFile(configPtr, outputHead);
       }
-      //clear memory
-      free(currentOpCmd);
+      //free process queue, current process is part of it
+      processQueue = clearProcessQueue(processQueue);
+      currentProcess = NULL;
 
-      //free process queue
-      queueHead = clearProcessQueue(queueHead);
+      //free output queue
+      outputHead = clearOutputList(outputHead);
 
-      free(currentProcess);
+      //free interrupt queue and any I/O still outstanding
+      interruptQueue = clearInterruptQueue(interruptQueue);
 
+      //free clock
+      simClock = clearSimClock(simClock);
 
-      //free output queue
+   }
 
-      outputHead = clearOutputList(outputHead);
+/*
+Function Name: appendTenthsToLine
+Algorithm: appends whole part, decimal point, and tenths digit
+Precondition: given line, its length, and value in tenths
+Postcondition: returns new line length
+Exceptions: none
+Notes: local to simulator, value is not negative
+*/
+static int appendTenthsToLine( char *line, int lineLength, long tenths )
+{
+   lineLength = appendIntToLine(line, lineLength, (int)(tenths / 10));
+   lineLength = appendToLine(line, lineLength, ".");
+   return appendIntToLine(line, lineLength, (int)(tenths % 10));
+}
 
+/*
+Function Name: reportBurstPredictions
+Algorithm: averages how far burst predictions were off, and which way,
+           over every CPU burst run
+Precondition: given process queue after its last process has exited,
+              output list, config data, and clock
+Postcondition: report is added to output list
+Exceptions: no report if no CPU burst was run
+Notes: compare SJF-N or SRTF-P run order with and without -bp to see
+       what exact knowledge of burst times is worth
+*/
+void reportBurstPredictions( ProcessQueue *processQueue, 
+                             outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock )
+{
+   char output[MAX_STR_LEN];
+   int outputLength;
+   long numBursts = processQueue->burstsPredicted;
+   long biasTotal = processQueue->predictionBiasTotal;
+   SimTime currentTime = accessTimer(simClock, LAP_TIMER);
+
+   if(numBursts == 0)
+   {
+      return;
+   }
+
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, 
+                                        " OS: Burst predictions off by ");
+   outputLength = appendTenthsToLine(output, outputLength,
+       (processQueue->predictionErrorTotal * 10 + numBursts / 2) / numBursts);
+   outputLength = appendToLine(output, outputLength, " ms on average over ");
+   outputLength = appendIntToLine(output, outputLength, (int) numBursts);
+   outputLength = appendToLine(output, outputLength, " CPU bursts of ");
+   outputLength = appendTenthsToLine(output, outputLength,
+             (processQueue->burstTimeTotal * 10 + numBursts / 2) / numBursts);
+   appendToLine(output, outputLength, " ms average");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, 
+                                        " OS: Burst predictions ran ");
+   if(biasTotal < 0)
+   {
+      outputLength = appendTenthsToLine(output, outputLength,
+                                (-biasTotal * 10 + numBursts / 2) / numBursts);
+      appendToLine(output, outputLength, " ms short on average");
+   }
+   else
+   {
+      outputLength = appendTenthsToLine(output, outputLength,
+                                 (biasTotal * 10 + numBursts / 2) / numBursts);
+      appendToLine(output, outputLength, " ms long on average");
+   }
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+}
+
+/*
+Function Name: reportCpuShares
+Algorithm: finds every process's share of CPU cycles run until first
+           process exited and its share of tickets, then adds a line per
+           process in process ID order
+Precondition: given process queue after its last process has exited,
+              output list, config data, and clock
+Postcondition: report is added to output list
+Exceptions: no report if no CPU cycles were run before first exit
+Notes: after first exit fewer processes compete, and every process
+       ends up running all its cycles, so only the time before it shows
+       the policy's shares; processes waiting on I/O still fall short
+*/
+void reportCpuShares( ProcessQueue *processQueue, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock )
+{
+   char output[MAX_STR_LEN];
+   int outputLength;
+   int numProcesses = 0;
+   int state;
+   int index;
+   long totalCycles = 0;
+   long totalTickets = 0;
+   ProcessControlBlock **processes;
+   ProcessControlBlock *pcb;
+   SimTime currentTime = accessTimer(simClock, LAP_TIMER);
+
+   //gather exited and any remaining processes by process ID
+   for(state = NEW; state <= EXITING; state++)
+   {
+      numProcesses += processQueue->stateCounts[ state ];
+   }
+   processes = (ProcessControlBlock **) 
+                      malloc(sizeof(ProcessControlBlock *) * (numProcesses + 1));
+   for(pcb = processQueue->exitedPtr; pcb != NULL; pcb = pcb->nextNode)
+   {
+      processes[ pcb->processID ] = pcb;
+   }
+   for(pcb = processQueue->headPtr; pcb != NULL; pcb = pcb->nextNode)
+   {
+      processes[ pcb->processID ] = pcb;
+   }
+
+   for(index = 0; index < numProcesses; index++)
+   {
+      totalCycles += processes[ index ]->cyclesAtFirstExit;
+      totalTickets += processes[ index ]->tickets;
    }
 
-ioData *addToInterruptQueue( ioData *localPtr, ioData *newIoCmd )
+   for(index = 0; index < numProcesses && totalCycles > 0; index++)
+   {
+      pcb = processes[ index ];
+      outputLength = startLogLine(output, currentTime);
+      outputLength = appendToLine(output, outputLength, " OS: Process ");
+      outputLength = appendIntToLine(output, outputLength, pcb->processID);
+      outputLength = appendToLine(output, outputLength, " ran ");
+      outputLength = appendTenthsToLine(output, outputLength,
+                          (pcb->cyclesAtFirstExit * 1000 + totalCycles / 2)
+                                                           / totalCycles);
+      outputLength = appendToLine(output, outputLength, 
+                        "% of CPU cycles before first exit, target ");
+      outputLength = appendTenthsToLine(output, outputLength,
+                          (pcb->tickets * 1000 + totalTickets / 2)
+                                                          / totalTickets);
+      outputLength = appendToLine(output, outputLength, "% from ");
+      outputLength = appendIntToLine(output, outputLength, pcb->tickets);
+      appendToLine(output, outputLength, " tickets");
+      *outputHead = addToOutputList(*outputHead, output, configPtr);
+   }
+
+   free(processes);
+}
+
+/*
+Function Name: reportPaging
+Algorithm: adds line with page faults and evictions of replacement
+           policy, then line with share of page references TLB held
+Precondition: given paged memory after last process has exited, output
+              list, config data, and clock
+Postcondition: report is added to output list
+Exceptions: no TLB line if no page was referenced
+Notes: run same workload with each -pg policy and frame count to compare
+       fault rates
+*/
+void reportPaging( PagedMemory *memory, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock )
 {
-   //check for local ptr assigned to null
-   if(localPtr == NULL)
+   char output[MAX_STR_LEN];
+   char policyName[STD_STR_LEN];
+   int outputLength;
+   SimTime currentTime = accessTimer(simClock, LAP_TIMER);
+
+   getPageReplaceName(memory->replaceCode, policyName);
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, " OS: ");
+   outputLength = appendToLine(output, outputLength, policyName);
+   outputLength = appendToLine(output, outputLength, " paging with ");
+   outputLength = appendIntToLine(output, outputLength, memory->numFrames);
+   outputLength = appendToLine(output, outputLength, " frames of ");
+   outputLength = appendIntToLine(output, outputLength, memory->pageSize);
+   outputLength = appendToLine(output, outputLength, " KB had ");
+   outputLength = appendIntToLine(output, outputLength,
+                                                (int) memory->pageFaults);
+   outputLength = appendToLine(output, outputLength, " page faults, ");
+   outputLength = appendIntToLine(output, outputLength,
+                                                 (int) memory->evictions);
+   appendToLine(output, outputLength, " evictions");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   if(memory->references == 0)
    {
-      //allocate memory for new node
-      localPtr = (ioData *) malloc(sizeof(ioData));
-      //assign all values to newly created node
-      copyString(localPtr->command, newIoCmd->command);
-      localPtr->endTime = newIoCmd->endTime;
-      localPtr->processID = newIoCmd->processID;
-      //assign next node to null
-      localPtr->nextNode = NULL;
-      //assign reported value
-      localPtr->reported = newIoCmd->reported;
+      return;
+   }
 
-      return localPtr;
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, " OS: TLB held ");
+   outputLength = appendTenthsToLine(output, outputLength,
+                       (memory->tlbHits * 1000 + memory->references / 2)
+                                                       / memory->references);
+   outputLength = appendToLine(output, outputLength, "% of ");
+   outputLength = appendIntToLine(output, outputLength,
+                                                (int) memory->references);
+   outputLength = appendToLine(output, outputLength, " page references, ");
+   outputLength = appendIntToLine(output, outputLength,
+                                                 (int) memory->tlbMisses);
+   appendToLine(output, outputLength, " misses");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+}
 
+/*
+Function Name: reportPlacement
+Algorithm: adds line with requests allocator failed and memory it gave
+           beyond what was asked, line with external fragmentation after
+           requests, and line with time spent in allocator
+Precondition: given placement after last process has exited, output
+              list, config data, and clock
+Postcondition: report is added to output list
+Exceptions: no report if no block was asked for
+Notes: time is measured on host clock, so it varies from run to run
+*/
+void reportPlacement( Placement *placement, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock )
+{
+   char output[MAX_STR_LEN];
+   char allocatorName[STD_STR_LEN];
+   int outputLength;
+   long requests = placement->requests;
+   long operations = placement->requests + placement->releases;
+   long wasteTenths = 0;
+   SimTime currentTime = accessTimer(simClock, LAP_TIMER);
+
+   if(requests == 0)
+   {
+      return;
+   }
+   if(placement->grantedTotal > 0)
+   {
+      wasteTenths = 
+         ((placement->grantedTotal - placement->requestedTotal) * 1000 
+                      + placement->grantedTotal / 2) / placement->grantedTotal;
    }
 
-  //assume not at end of list
-  localPtr->nextNode = addToInterruptQueue(localPtr->nextNode, newIoCmd);
-  return localPtr;
-   
+   getPlacementName(placement->placeCode, allocatorName);
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, " OS: ");
+   outputLength = appendToLine(output, outputLength, allocatorName);
+   outputLength = appendToLine(output, outputLength, " placement failed ");
+   outputLength = appendIntToLine(output, outputLength,
+                                                  (int) placement->failures);
+   outputLength = appendToLine(output, outputLength, " of ");
+   outputLength = appendIntToLine(output, outputLength, (int) requests);
+   outputLength = appendToLine(output, outputLength, " requests, ");
+   outputLength = appendTenthsToLine(output, outputLength,
+               (placement->failures * 1000 + requests / 2) / requests);
+   outputLength = appendToLine(output, outputLength, "%, ");
+   outputLength = appendTenthsToLine(output, outputLength, wasteTenths);
+   appendToLine(output, outputLength, "% of memory given was not asked for");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, 
+                              " OS: Free memory outside largest free block ");
+   outputLength = appendTenthsToLine(output, outputLength,
+          (placement->fragmentationTotal + requests / 2) / requests);
+   outputLength = appendToLine(output, outputLength, 
+                                            "% on average, peak ");
+   outputLength = appendTenthsToLine(output, outputLength,
+                                             placement->peakFragmentation);
+   appendToLine(output, outputLength, "%");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   outputLength = startLogLine(output, currentTime);
+   outputLength = appendToLine(output, outputLength, " OS: Allocator took ");
+   outputLength = appendTenthsToLine(output, outputLength,
+          (long)((placement->allocatorTime / 100 + operations / 2) 
+                                                              / operations));
+   outputLength = appendToLine(output, outputLength, 
+                                      " us per request or release over ");
+   outputLength = appendIntToLine(output, outputLength, (int) operations);
+   appendToLine(output, outputLength, " operations");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+   if(placement->compactions > 0)
+   {
+      outputLength = startLogLine(output, currentTime);
+      outputLength = appendToLine(output, outputLength, 
+                                                 " OS: Compacted memory ");
+      outputLength = appendIntToLine(output, outputLength,
+                                               (int) placement->compactions);
+      outputLength = appendToLine(output, outputLength, " times, copying ");
+      outputLength = appendIntToLine(output, outputLength,
+                                             (int) placement->compactedSize);
+      appendToLine(output, outputLength, " KB");
+      *outputHead = addToOutputList(*outputHead, output, configPtr);
+   }
 }
 
 /*
-Removes given node from queue
+Function Name: reportWheelExpiries
+Algorithm: adds line with total I/O events expired by timing wheel, the
+           ticks that expired any, and most expired by one tick
+Precondition: given timing wheel, output list, config data, and clock
+Postcondition: report is added to output list
+Exceptions: none
+Notes: tick still in progress is counted as finished
 */
-ioData *dequeue( ioData *current, ioData *toRemove)
+void reportWheelExpiries( TimingWheel *wheel, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock )
 {
-   //check if we are at the end
-   if(current == NULL)
+   char output[MAX_STR_LEN];
+   int outputLength;
+   long ticksWithExpiry = wheel->ticksWithExpiry;
+   int maxExpiredPerTick = wheel->maxExpiredPerTick;
+
+   if(wheel->expiredThisTick > 0)
    {
-      return NULL;
+      ticksWithExpiry++;
+      if(wheel->expiredThisTick > maxExpiredPerTick)
+      {
+         maxExpiredPerTick = wheel->expiredThisTick;
+      }
    }
 
-   //check if this is the node to remove
-   if(compareString(toRemove->command, current->command) == STR_EQ
-         && (toRemove->processID == current->processID))
+   outputLength = startLogLine(output, accessTimer(simClock, LAP_TIMER));
+   outputLength = appendToLine(output, outputLength, 
+                                           " OS: Timing wheel expired ");
+   outputLength = appendIntToLine(output, outputLength, 
+                                                (int)wheel->expiredTotal);
+   outputLength = appendToLine(output, outputLength, " I/O events in ");
+   outputLength = appendIntToLine(output, outputLength, (int)ticksWithExpiry);
+   outputLength = appendToLine(output, outputLength, " ticks, at most ");
+   outputLength = appendIntToLine(output, outputLength, maxExpiredPerTick);
+   appendToLine(output, outputLength, " per tick");
+   *outputHead = addToOutputList(*outputHead, output, configPtr);
+}
+
+/*
+Function Name: createInterruptQueue
+Algorithm: creates empty interrupt queue backed by a min heap, or by a
+           timing wheel with one I/O cycle per tick if configured
+Precondition: given config data
+Postcondition: returns pointer to empty queue
+Exceptions: none
+Notes: none
+*/
+InterruptQueue *createInterruptQueue( ConfigDataType *configPtr )
+{
+   InterruptQueue *queue = (InterruptQueue *) malloc(sizeof(InterruptQueue));
+
+   queue->pending = createMinHeap(STD_STR_LEN);
+   queue->wheel = NULL;
+   queue->requestCount = 0;
+
+   if(configPtr->timingWheel == True)
    {
+      queue->wheel = createTimingWheel(
+                             (SimTime)configPtr->ioCycleRate * NSEC_PER_MSEC);
+   }
 
-      ioData *tempNext = current->nextNode;
-      free(current);
-      current = NULL;
+   return queue;
+}
 
+/*
+Function Name: clearInterruptQueue
+Algorithm: frees any I/O left in queue, then queue itself
+Precondition: given queue or NULL
+Postcondition: queue memory freed, returns NULL
+Exceptions: none
+Notes: none
+*/
+InterruptQueue *clearInterruptQueue( InterruptQueue *queue )
+{
+   if(queue != NULL)
+   {
+      while(heapIsEmpty(queue->pending) == False)
+      {
+         free(popHeapItem(queue->pending));
+      }
+      queue->pending = clearMinHeap(queue->pending);
+      queue->wheel = clearTimingWheel(queue->wheel, free);
+      free(queue);
+   }
+   return NULL;
+}
 
-      return tempNext;
+/*
+Function Name: addToInterruptQueue
+Algorithm: inserts I/O into heap keyed by its end time
+Precondition: given queue and allocated I/O data
+Postcondition: queue owns I/O data until it is dequeued
+Exceptions: none
+Notes: requests ending at same time come out in request order, O(log n),
+       or O(1) on timing wheel
+*/
+void addToInterruptQueue( InterruptQueue *queue, ioData *newIoCmd )
+{
+   if(queue->wheel != NULL)
+   {
+      addToTimingWheel(queue->wheel, newIoCmd->endTime, newIoCmd);
+      return;
    }
-   
-   //go to next queue entry
-   current->nextNode = dequeue(current->nextNode, toRemove);
 
-   return current;
-   
+   insertHeapItem(queue->pending, newIoCmd->endTime, queue->requestCount,
+                                              newIoCmd, &newIoCmd->heapIndex);
+   queue->requestCount++;
+}
+
+/*
+Function Name: getEarliestInterrupt
+Algorithm: peeks at top of heap
+Precondition: given queue
+Postcondition: returns earliest end time of all I/O operations in queue,
+               or zero if queue is empty
+Exceptions: none
+Notes: O(1), timing wheel scans forward to its next filled slot
+*/
+SimTime getEarliestInterrupt( InterruptQueue *queue )
+{
+   if(queue->wheel != NULL)
+   {
+      return getNextWheelExpiry(queue->wheel);
+   }
+
+   if(heapIsEmpty(queue->pending) == True)
+   {
+      return 0;
+   }
+   return peekHeapKey(queue->pending);
+}
+
+/*
+Function Name: interruptQueueIsEmpty
+Algorithm: checks heap, or timing wheel's pending and expired items
+Precondition: given queue
+Postcondition: returns true if queue holds no I/O
+Exceptions: none
+Notes: none
+*/
+Boolean interruptQueueIsEmpty( InterruptQueue *queue )
+{
+   if(queue->wheel != NULL)
+   {
+      return queue->wheel->pendingCount == 0
+                   && peekExpiredItem(queue->wheel) == NULL;
+   }
+   return heapIsEmpty(queue->pending);
+}
+
+/*
+Function Name: dequeue
+Algorithm: removes I/O from heap by the index it carries
+Precondition: given queue and I/O data currently in it
+Postcondition: I/O removed from queue and handed back to caller to free
+Exceptions: none
+Notes: O(log n), no search of queue; timing wheel only hands out
+       expired I/O, so only the oldest expired I/O can be removed there
+*/
+ioData *dequeue( InterruptQueue *queue, ioData *toRemove )
+{
+   if(queue->wheel != NULL)
+   {
+      if(peekExpiredItem(queue->wheel) != toRemove)
+      {
+         return NULL;
+      }
+      return (ioData *) popExpiredItem(queue->wheel);
+   }
+   return (ioData *) removeHeapItem(queue->pending, toRemove->heapIndex);
+}
+
+/*
+Function Name: getFinishedInterrupt
+Algorithm: heap: peeks at earliest I/O and checks its end time;
+           timing wheel: expires everything due, then peeks at oldest
+Precondition: given queue and current time
+Postcondition: returns finished I/O still in queue, or NULL if none
+Exceptions: none
+Notes: one comparison on heap, amortized O(1) on timing wheel
+*/
+ioData *getFinishedInterrupt( InterruptQueue *queue, SimTime currentTime )
+{
+   ioData *earliest;
+
+   if(queue->wheel != NULL)
+   {
+      advanceTimingWheel(queue->wheel, currentTime);
+      return (ioData *) peekExpiredItem(queue->wheel);
+   }
+
+   earliest = (ioData *) peekHeapItem(queue->pending);
+   if(earliest != NULL && earliest->endTime <= currentTime)
+   {
+      return earliest;
+   }
+   return NULL;
 }
 
 /*
@@ -263,167 +752,484 @@ If interruptCtrlCode is CLEAR_ALL_INTERRUPTS, checks for finished interrupts,
    reports unreported interrupts, and clears them from the queue
 Returns true is there were unreported, finished interrupts and false otherwise
    if CHECK_FOR_INTERRUPTS was code, if not returns false for other ctrl codes
+Only the earliest pending I/O is ever looked at, an interrupt reported by
+   CHECK_FOR_INTERRUPTS is always cleared before the next check
 */
-Boolean manageInterrupts(int interruptCtrlCode, ioData *ioReturnData, ioData **interruptHead, 
-                           ProcessControlBlock **queueHead, outputNode **outputHead,
-                           ConfigDataType *configPtr)
+Boolean manageInterrupts(int interruptCtrlCode, ioData *ioReturnData, 
+                           InterruptQueue *interruptQueue, 
+                           ProcessQueue *processQueue, outputNode **outputHead,
+                           ConfigDataType *configPtr, SimClock *simClock)
 {
-   ioData *tempPtr = *interruptHead;
-   double currentTime;
-   char timeBuffer[STD_STR_LEN];
-   currentTime = accessTimer(LAP_TIMER, timeBuffer);
+   ioData *tempPtr;
+   SimTime currentTime;
+   currentTime = accessTimer(simClock, LAP_TIMER);
    char output[MAX_STR_LEN];
-   char intBuffer[STD_STR_LEN];
-
-
-
+   int outputLength;
 
    if(interruptCtrlCode == SIGNAL_INTERRUPT)
    {
       //add returned IO output to queue
-         *interruptHead = addToInterruptQueue(*interruptHead, ioReturnData);
+         addToInterruptQueue(interruptQueue, ioReturnData);
 
    }
 
    else if(interruptCtrlCode == CHECK_FOR_INTERRUPTS)
    {
-      //interate through interrupt queue
+      //only earliest I/O can have finished
+      tempPtr = getFinishedInterrupt(interruptQueue, currentTime);
+
+      //if interrupt is done and not reported, report new interrupt
+      if(tempPtr != NULL && tempPtr->reported == False)
+      {
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         outputLength = startLogLine(output, currentTime);
+         outputLength = appendToLine(output, outputLength,
+                                        " OS: Interrupted by process ");
+         outputLength = appendIntToLine(output, outputLength,
+                                                   tempPtr->processID);
+         outputLength = appendToLine(output, outputLength, " ");
+         outputLength = appendToLine(output, outputLength, tempPtr->command);
+         appendToLine(output, outputLength, "end");
+         *outputHead = addToOutputList(*outputHead, output, configPtr);
+
+         tempPtr->reported = True;
+
+         return True;
+      }
+      return False;
+   } 
+   else
+   {
+      //check if io should be done and clear any finished io,
+      // earliest first
+      tempPtr = getFinishedInterrupt(interruptQueue, currentTime);
       while(tempPtr != NULL)
-      { 
-         //if interrupt is done and not reported, report new interrupt
-         if(tempPtr->endTime > currentTime)
+      {
+         //get to process I/O came from
+         ProcessControlBlock *processPtr = tempPtr->process;
+         ProcessControlBlock **processToModify;
+
+         //increment next instruction pointer for process I/O came from
+         processToModify = &processPtr;
+         (*processToModify)->nextOpCommand = (*processToModify)->nextOpCommand->nextNode;
+         //change process from waiting to ready
+         setProcessReady(processQueue, *processToModify);
+
+         //if interrupt not already reported, report
+         if(tempPtr->reported == False)
          {
+            currentTime = accessTimer(simClock, LAP_TIMER);
+            outputLength = startLogLine(output, currentTime);
+            outputLength = appendToLine(output, outputLength, " OS: Process ");
+            outputLength = appendIntToLine(output, outputLength,
+                                            (*processToModify)->processID);
+            outputLength = appendToLine(output, outputLength, " ");
+            outputLength = appendToLine(output, outputLength, 
+                                                        tempPtr->command);
+            appendToLine(output, outputLength, "end");
+            *outputHead = addToOutputList(*outputHead, output, configPtr);
+         }
+       
+         //remove interrupt from queue
+         free(dequeue(interruptQueue, tempPtr));
 
-           if(tempPtr->reported == False)
-           {
-              currentTime = accessTimer(LAP_TIMER, timeBuffer);
-              sprintf(output, "%f", currentTime);
-              concatenateString(output, ", ");
+         tempPtr = getFinishedInterrupt(interruptQueue, currentTime);
+      }
 
-              concatenateString(output, " OS: Interrupted by process ");
-              sprintf(intBuffer, "%d", tempPtr->processID);
- 
-              concatenateString(output, intBuffer);
-              concatenateString(output, " ");
-              concatenateString(output, tempPtr->command);
-              concatenateString(output, "end");
-              *outputHead = addToOutputList(*outputHead, output, configPtr);
+   }
+   return False;
+}
 
-              tempPtr->reported = True;
+/*
+Function Name: getCycleHorizon
+Algorithm: starts with cycles left in burst, cuts that to cycles left in
+           quantum and to cycles until earliest pending I/O has ended
+Precondition: given running process, cycles completed since it was
+              dispatched, policy's quantum for it, interrupt queue, config
+              data, and clock with a run started
+Postcondition: returns number of cycles, at least one, that can run before
+               an interrupt or quantum check could first succeed
+Exceptions: none
+Notes: measured from the run deadline rather than a lap of the clock,
+       so the same cycles are grouped on every run; preemptive runs only
+*/
+int getCycleHorizon( ProcessControlBlock *currentProcess, int cpuCyclesCompleted,
+                     int quantumCycles, InterruptQueue *interruptQueue,
+                     ConfigDataType *configPtr, SimClock *simClock )
+{
+   int cyclesToRun = currentProcess->cpuCyclesLeft;
+   SimTime cycleTime = (SimTime)configPtr->procCycleRate * NSEC_PER_MSEC;
+   SimTime timeToInterrupt;
+   SimTime cyclesToInterrupt;
+
+   //stop at quantum
+   if(quantumCycles > cpuCyclesCompleted
+         && quantumCycles - cpuCyclesCompleted < cyclesToRun)
+   {
+      cyclesToRun = quantumCycles - cpuCyclesCompleted;
+   }
 
-              return True;
+   //stop at first cycle ending at or after earliest I/O end
+   if(cycleTime > 0 && interruptQueueIsEmpty(interruptQueue) == False)
+   {
+      timeToInterrupt = getEarliestInterrupt(interruptQueue) 
+                                              - getRunDeadline(simClock);
+      cyclesToInterrupt = (timeToInterrupt + cycleTime - 1) / cycleTime;
 
-               
-            }
+      if(cyclesToInterrupt < cyclesToRun)
+      {
+         cyclesToRun = (int)cyclesToInterrupt;
+      }
+   }
 
-         }
-         tempPtr = tempPtr->nextNode;
+   if(cyclesToRun < 1)
+   {
+      cyclesToRun = 1;
+   }
+   return cyclesToRun;
+}
+
+/*
+Function Name: runWholeBurst
+Algorithm: waits out every cycle left in CPU burst at once
+Precondition: given output list, config data, running process, process
+              queue, interrupt queue, clock, and command being run
+Postcondition: burst is finished, process time and cycles are updated
+Exceptions: none
+Notes: non-preemptive kernel; nothing can stop a burst, so there is no
+       quantum or interrupt check
+*/
+static outputNode *runWholeBurst( outputNode *headPtr, ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess, ProcessQueue *processQueue,
+                     InterruptQueue *interruptQueue, SimClock *simClock,
+                     char *processCmd )
+{
+   int cyclesToRun = currentProcess->cpuCyclesLeft;
+
+   startTimerRun(simClock);
+   if(cyclesToRun > 0)
+   {
+      waitTimer(simClock, cyclesToRun * configPtr->procCycleRate);
+
+      currentProcess->timeRemaining -= cyclesToRun * configPtr->procCycleRate;
+      currentProcess->cpuCyclesLeft = 0;
+      currentProcess->cpuCyclesRun += cyclesToRun;
+
+      //let policy account for cycles run
+      if(processQueue->policy->onTick != NULL)
+      {
+         processQueue->policy->onTick(processQueue, currentProcess,
+                                                              cyclesToRun);
       }
-      return False;
-   } 
-   else
+   }
+   return headPtr;
+}
+
+/*
+Function Name: runSlicedBurst
+Algorithm: runs CPU burst in steps up to the next possible interrupt or
+           quantum end, giving up CPU to an I/O end the policy allows
+           or at quantum time out
+Precondition: given output list, config data, running process, process
+              queue, interrupt queue, clock, and command being run
+Postcondition: burst is finished or process is READY again
+Exceptions: none
+Notes: preemptive kernel
+*/
+static outputNode *runSlicedBurst( outputNode *headPtr, ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess, ProcessQueue *processQueue,
+                     InterruptQueue *interruptQueue, SimClock *simClock,
+                     char *processCmd )
+{
+   char endOutput[MAX_STR_LEN];
+   int endLength;
+   int cpuCyclesCompleted = 0;
+   int cyclesToRun;
+   int commandTime = configPtr->procCycleRate;
+   const SchedPolicy *policy = processQueue->policy;
+   ProcessControlBlock *wokenProcess;
+   int quantumCycles = policy->getQuantum(processQueue, currentProcess,
+                                                                 configPtr);
+   SimTime currentTime;
+
+   //schedule every cycle from the start of this run
+   startTimerRun(simClock);
+   while(currentProcess->cpuCyclesLeft > 0 && currentProcess->processState == RUNNING)
    {
-      //check if io should be done and clear any finished io
-      while(*interruptHead != NULL && tempPtr != NULL)
+      //run every cycle that can pass before anything could happen
+      cyclesToRun = getCycleHorizon(currentProcess, cpuCyclesCompleted,
+                         quantumCycles, interruptQueue, configPtr, simClock);
+      waitTimer(simClock, cyclesToRun * commandTime);
+
+      //increment completed cycles
+      cpuCyclesCompleted += cyclesToRun;
+
+      //update time remaining, subtract cycle times
+      currentProcess->timeRemaining -= cyclesToRun * configPtr->procCycleRate;
+      //reduce number of cycles remaining
+      currentProcess->cpuCyclesLeft -= cyclesToRun;
+      currentProcess->cpuCyclesRun += cyclesToRun;
+
+      //let policy account for cycles run
+      if(policy->onTick != NULL)
       {
-         if(currentTime > tempPtr->endTime)
+         policy->onTick(processQueue, currentProcess, cyclesToRun);
+      }
+
+      //check for interrupts, policy decides if they take the CPU
+      if(manageInterrupts(CHECK_FOR_INTERRUPTS, NULL, interruptQueue, 
+                processQueue, &headPtr, configPtr, simClock) == True)
+      {
+         //interrupt just reported is still first finished I/O
+         wokenProcess = getFinishedInterrupt(interruptQueue, 
+                                  accessTimer(simClock, LAP_TIMER))->process;
+
+         if(policy->shouldPreempt(processQueue, currentProcess, 
+                                                    wokenProcess) == True)
          {
-            //get to process I/O came from
-            ProcessControlBlock *processPtr = *queueHead;
-            ProcessControlBlock **processToModify;
-            while((processPtr)->processID != tempPtr->processID)
+            setProcessReady(processQueue, currentProcess);
+            //if we finished cycles, move command forward
+            if(currentProcess->cpuCyclesLeft == 0)
             {
-               (processPtr) = (processPtr)->nextNode;
+               currentProcess->nextOpCommand = 
+                                currentProcess->nextOpCommand->nextNode;  
             }
-            //increment next instruction pointer for process I/O came from
-            processToModify = &processPtr;
-            (*processToModify)->nextOpCommand = (*processToModify)->nextOpCommand->nextNode;
-            //change process from waiting to ready
-            (*processToModify)->processState = READY;
-
-           //if interrupt not already reported, report
-           if(tempPtr->reported == False)
-           {
-              currentTime = accessTimer(LAP_TIMER, timeBuffer);
-              sprintf(output, "%f", currentTime);
-              concatenateString(output, ", ");
+         }
+         else
+         {
+            //running process keeps CPU, woken process waits its turn
+            manageInterrupts(CLEAR_ALL_INTERRUPTS, NULL, interruptQueue, 
+                             processQueue, &headPtr, configPtr, simClock);
+         }
+      }
 
-              concatenateString(output, " OS: Process ");
-              sprintf(intBuffer, "%d", (*processToModify)->processID);
- 
-              concatenateString(output, intBuffer);
-              concatenateString(output, " ");
-              concatenateString(output, tempPtr->command);
-              concatenateString(output, "end");
-              *outputHead = addToOutputList(*outputHead, output, configPtr);
-               
-           }
-       
-            //remove interrupt from queue
-            *interruptHead = dequeue(*interruptHead, tempPtr);
+      //check for time quantum
+      if(cpuCyclesCompleted == quantumCycles)
+      {
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startProcessLogLine(endOutput, currentTime,
+                                                            currentProcess);
+         endLength = appendToLine(endOutput, endLength, "quantum time out, ");
+         endLength = appendToLine(endOutput, endLength, processCmd);
+         appendToLine(endOutput, endLength, " operation end");
+         headPtr = addToOutputList(headPtr, endOutput, configPtr);
 
+         //if we didn't finish cycles, set to ready 
+         if(currentProcess->cpuCyclesLeft != 0)
+         {
+            setProcessReady(processQueue, currentProcess);
          }
-         tempPtr = tempPtr->nextNode;
       }
+   }
+   return headPtr;
+}
+
+/*
+Function Name: runBlockingIo
+Algorithm: reports start of I/O, waits it out, and reports its end
+Precondition: given output list, config data, running process, I/O
+              command, process queue, interrupt queue, clock, start line
+              holding process header, its length, and I/O description
+Postcondition: I/O is finished, process is still RUNNING
+Exceptions: none
+Notes: non-preemptive kernel
+*/
+static outputNode *runBlockingIo( outputNode *headPtr, ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess, OpCodeType *currentCommand,
+                     ProcessQueue *processQueue, InterruptQueue *interruptQueue,
+                     SimClock *simClock, char *startOutput, int startLength,
+                     char *processCmd )
+{
+   char endOutput[MAX_STR_LEN];
+   int endLength;
+   int commandTime;
+   SimTime currentTime;
+
+   startLength = appendToLine(startOutput, startLength, processCmd);
+   appendToLine(startOutput, startLength, " start");
+
+   headPtr = addToOutputList(headPtr, startOutput, configPtr);
+
+   //get command time
+   commandTime = getCommandTime(currentCommand, configPtr);
+
+   //run timer
+   startTimerRun(simClock);
+   waitTimer(simClock, commandTime);
+
+   //report end of command
+   currentTime = accessTimer(simClock, LAP_TIMER);
+   endLength = startProcessLogLine(endOutput, currentTime, currentProcess);
+   endLength = appendToLine(endOutput, endLength, processCmd);
+   appendToLine(endOutput, endLength, "end");
+   headPtr = addToOutputList(headPtr, endOutput, configPtr);
+
+   return headPtr;
+}
+
+/*
+Function Name: startInterruptIo
+Algorithm: reports process blocked, queues I/O to end by interrupt, and
+           sets process WAITING
+Precondition: given output list, config data, running process, I/O
+              command, process queue, interrupt queue, clock, start line
+              holding process header, its length, and I/O description
+Postcondition: interrupt queue owns new I/O until it is cleared
+Exceptions: none
+Notes: preemptive kernel
+*/
+static outputNode *startInterruptIo( outputNode *headPtr, ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess, OpCodeType *currentCommand,
+                     ProcessQueue *processQueue, InterruptQueue *interruptQueue,
+                     SimClock *simClock, char *startOutput, int startLength,
+                     char *processCmd )
+{
+   //interrupt queue owns this until I/O is cleared
+   ioData *ioCommand = (ioData *)malloc(sizeof(ioData));
+   SimTime currentTime;
+
+   copyString(ioCommand->command, processCmd);
+   startLength = appendToLine(startOutput, startLength, "blocked for ");
+   appendToLine(startOutput, startLength, processCmd);
+
+   headPtr = addToOutputList(headPtr, startOutput, configPtr);
+
+   //get process ID
+   ioCommand->processID = currentProcess->processID;
+   ioCommand->process = currentProcess;
+
+   //get command time
+   currentTime = accessTimer(simClock, LAP_TIMER);
+   ioCommand->endTime = currentTime 
+            + (SimTime)getCommandTime(currentCommand, configPtr) * NSEC_PER_MSEC;
+   ioCommand->heapIndex = NOT_IN_HEAP;
+
+   ioCommand->reported = False;
+
+   //set process to waiting
+   setProcessState(processQueue, currentProcess, WAITING);
 
+   //update time remaining
+   currentProcess->timeRemaining -= getCommandTime(currentCommand, configPtr);
+   manageInterrupts(SIGNAL_INTERRUPT, ioCommand, interruptQueue, 
+                    processQueue, &headPtr, configPtr, simClock);
+
+   return headPtr;
+}
+
+//kernels, one per kind of policy
+static const SimKernel WHOLE_BURST_KERNEL 
+                          = { False, runWholeBurst, runBlockingIo };
+static const SimKernel SLICED_BURST_KERNEL 
+                          = { True, runSlicedBurst, startInterruptIo };
+
+/*
+Function Name: getSimKernel
+Algorithm: picks preemptive or non-preemptive kernel for policy
+Precondition: given scheduling policy
+Postcondition: returns kernel to use for whole run
+Exceptions: none
+Notes: chosen once, so ops and cycles never test preemption again
+*/
+const SimKernel *getSimKernel( const SchedPolicy *policy )
+{
+   if(policy->preemptive == True)
+   {
+      return &SLICED_BURST_KERNEL;
    }
-   return False;
+   return &WHOLE_BURST_KERNEL;
+}
+
+/*
+Function Name: servicePageFaults
+Algorithm: touches pages of memory access, then, if any had to be
+           loaded, reports faults and runs an input operation of one I/O
+           cycle per page loaded
+Precondition: given output list, config data, running process whose
+              access has succeeded, process queue, interrupt queue, clock,
+              and kernel chosen for run's policy
+Postcondition: every page of access is resident; with a fault, process
+               has blocked or waited for page loads like any I/O
+Exceptions: none
+Notes: local to simulator; page loads were not known when time remaining
+       was worked out, so they are added to it
+*/
+static outputNode *servicePageFaults( outputNode *headPtr,
+                     ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess, 
+                     ProcessQueue *processQueue, InterruptQueue *interruptQueue,
+                     SimClock *simClock, const SimKernel *kernel )
+{
+   OpCodeType faultCommand;
+   char processCmd[STD_STR_LEN];
+   char startOutput[MAX_STR_LEN];
+   int startLength;
+   int numFaults = touchPages(processQueue->pagedMemory, currentProcess,
+                                       currentProcess->nextOpCommand->intArg2,
+                                       currentProcess->nextOpCommand->intArg3);
+
+   if(numFaults == 0)
+   {
+      return headPtr;
+   }
+
+   startLength = startLogLine(startOutput, accessTimer(simClock, LAP_TIMER));
+   startLength = appendToLine(startOutput, startLength, " OS: Process ");
+   startLength = appendIntToLine(startOutput, startLength,
+                                                 currentProcess->processID);
+   startLength = appendToLine(startOutput, startLength, " page fault on ");
+   startLength = appendIntToLine(startOutput, startLength, numFaults);
+   appendToLine(startOutput, startLength, " pages");
+   headPtr = addToOutputList(headPtr, startOutput, configPtr);
+
+   //page loads are device input of one cycle per page
+   copyString(faultCommand.command, "dev");
+   copyString(faultCommand.inOutArg, "in");
+   copyString(faultCommand.strArg1, "page fault");
+   faultCommand.intArg2 = numFaults;
+   copyString(processCmd, "page fault input operation ");
+   currentProcess->timeRemaining += getCommandTime(&faultCommand, configPtr);
+
+   startLength = startProcessLogLine(startOutput, 
+                       accessTimer(simClock, LAP_TIMER), currentProcess);
+   return kernel->runIo(headPtr, configPtr, currentProcess, &faultCommand,
+                            processQueue, interruptQueue, simClock, 
+                            startOutput, startLength, processCmd);
 }
 
 /*
 Function Name: processLine
 Algorithm: reports time remaining, command, and starting/ending
 Precondition: given pointer to process control block, config pointer,
-              and head of linked list containing output, head of process queue.
-              and head of interrupt queue   
+              and head of linked list containing output, head of process queue,
+              head of interrupt queue, clock of this simulation run, and
+              kernel chosen for run's policy
 Postcondition: adds report of start and end to linked list containing output
 Exceptions: none
 Notes: none
 */
 outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
-                     ProcessControlBlock **currentProcess, ProcessControlBlock *processQueueHead,
-                     ioData **interruptHead )
+                     ProcessControlBlock **currentProcess, ProcessQueue *processQueue,
+                     InterruptQueue *interruptQueue, SimClock *simClock,
+                     const SimKernel *kernel )
 {
    //initialize variables
-   char header[STD_STR_LEN];
    char processCmd[STD_STR_LEN];
    char startOutput[MAX_STR_LEN];
    char endOutput[MAX_STR_LEN];
-   char intBuffer[STD_STR_LEN];
-   char timeBuffer[STD_STR_LEN];
-   int commandTime;
-   int *commandTimePtr;
-   int cpuCyclesCompleted;
-   double currentTime;
-   pthread_t tid;
-   Boolean preemptive;
+   int startLength;
+   int endLength;
+   int processCmdLength;
+   SimTime currentTime;
    OpCodeType *currentCommand = (*currentProcess)->nextOpCommand; 
 
-   if(configPtr->cpuSchedCode == CPU_SCHED_SRTF_P_CODE
-           || configPtr->cpuSchedCode == CPU_SCHED_FCFS_P_CODE
-           || configPtr->cpuSchedCode == CPU_SCHED_RR_P_CODE)
-      {
-            preemptive = True;
-      }
-     else
-     {
-        preemptive = False;
-     } 
-
    
 
    //report time 
-   currentTime = accessTimer(LAP_TIMER, timeBuffer);
-
-   //report initial information at start
-   sprintf(header, "%s", " Process: ");
-   sprintf(intBuffer, "%d", currentCommand->pid);
-   concatenateString(header, intBuffer);
-   concatenateString(header, ", ");
+   currentTime = accessTimer(simClock, LAP_TIMER);
 
    //report time
-   sprintf(startOutput, "%f", currentTime);
-   concatenateString(startOutput, ", ");
+   startLength = startLogLine(startOutput, currentTime);
 
 
    
@@ -433,7 +1239,7 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
    {
 
       //print OS
-      concatenateString(startOutput, " OS: Simulator start");
+      appendToLine(startOutput, startLength, " OS: Simulator start");
       
       headPtr = addToOutputList(headPtr, startOutput, configPtr);
      
@@ -447,19 +1253,33 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
       {
        
         //modify process state 
-         (*currentProcess)->processState = EXITING;
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(startOutput, "%f", currentTime);
-         concatenateString(startOutput, ", ");
-
-         concatenateString(startOutput, " OS: Process ");
-         sprintf(intBuffer, "%d", (*currentProcess)->processID);
- 
-         concatenateString(startOutput, intBuffer);
-         concatenateString(startOutput, " ");
-         concatenateString(startOutput, "set from RUNNING to EXITING");
+         setProcessState(processQueue, *currentProcess, EXITING);
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         startLength = startLogLine(startOutput, currentTime);
+         startLength = appendToLine(startOutput, startLength, " OS: Process ");
+         startLength = appendIntToLine(startOutput, startLength,
+                                                (*currentProcess)->processID);
+         appendToLine(startOutput, startLength, " set from RUNNING to EXITING");
  
          headPtr = addToOutputList(headPtr, startOutput, configPtr);
+
+         //report a deadline missed, under any policy
+         if((*currentProcess)->absoluteDeadline != 0 
+               && currentTime > (*currentProcess)->absoluteDeadline)
+         {
+            startLength = startLogLine(startOutput, currentTime);
+            startLength = appendToLine(startOutput, startLength, 
+                                                           " OS: Process ");
+            startLength = appendIntToLine(startOutput, startLength,
+                                                (*currentProcess)->processID);
+            startLength = appendToLine(startOutput, startLength, 
+                                                      " missed deadline by ");
+            startLength = appendTenthsToLine(startOutput, startLength,
+                    (long)((currentTime - (*currentProcess)->absoluteDeadline)
+                                                      / (NSEC_PER_MSEC / 10)));
+            appendToLine(startOutput, startLength, " ms");
+            headPtr = addToOutputList(headPtr, startOutput, configPtr);
+         }
       }
 
    }
@@ -468,90 +1288,47 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
    if(compareString(currentCommand->command, "cpu") == STR_EQ)
    {
       //print process
-      concatenateString(startOutput, header);
+      startLength = startProcessLogLine(startOutput, currentTime, 
+                                                            *currentProcess);
 
      
       //print second command
       
-      sprintf(processCmd, "%s", currentCommand->command);
-      concatenateString(processCmd, " ");
+      processCmdLength = appendToLine(processCmd, 0, currentCommand->command);
+      processCmdLength = appendToLine(processCmd, processCmdLength, " ");
 
       //print str arg
-      concatenateString(processCmd, currentCommand->strArg1);
+      appendToLine(processCmd, processCmdLength, currentCommand->strArg1);
       
       //report start
-      concatenateString(startOutput, processCmd);
-      concatenateString(startOutput, " start");
+      startLength = appendToLine(startOutput, startLength, processCmd);
+      appendToLine(startOutput, startLength, " start");
       headPtr = addToOutputList(headPtr, startOutput, configPtr);
 
-      //get command time and number of cycles
-      commandTime = configPtr->procCycleRate;
-      commandTimePtr = &commandTime;
-      cpuCyclesCompleted = 0;
-      while((*currentProcess)->cpuCyclesLeft > 0 && (*currentProcess)->processState == RUNNING)
-      {
-         //run timer
-         pthread_create(&tid, NULL, runTimer, (void *)commandTimePtr);
-         pthread_join(tid, NULL);
-      
-         //increment completed cycles
-         cpuCyclesCompleted++;
-
-         //update time remaining, subtract one cycle time
-         (*currentProcess)->timeRemaining -= configPtr->procCycleRate;
-         //reduce number of cycles remaining
-         (*currentProcess)->cpuCyclesLeft--;
-
-         //check for interrupts
-         if(preemptive == True && manageInterrupts(CHECK_FOR_INTERRUPTS, NULL, interruptHead, 
-                   &processQueueHead, &headPtr, configPtr) == True)
-         {
-             (*currentProcess)->processState = READY;
-             //if we finished cycles, move command forward
-             if((*currentProcess)->cpuCyclesLeft == 0)
-             {
-                (*currentProcess)->nextOpCommand = 
-                   (*currentProcess)->nextOpCommand->nextNode;  
-             }
-         }
-         //if preemptive, check for time quantum
-         if(preemptive == True)
-         {
-            if(cpuCyclesCompleted == configPtr->quantumCycles)
-            {
-                currentTime = accessTimer(LAP_TIMER, timeBuffer);
-                sprintf(endOutput, "%f", currentTime);
-                concatenateString(endOutput, ", ");
-                concatenateString(endOutput, header);
-                concatenateString(endOutput, "quantum time out, ");
-                concatenateString(endOutput, processCmd);
-                concatenateString(endOutput, " operation end");
-                headPtr = addToOutputList(headPtr, endOutput, configPtr);
-                 
-                //if we didn't finish cycles, set to ready 
-                if((*currentProcess)->cpuCyclesLeft != 0)
-                {
-                   (*currentProcess)->processState = READY;
-                }
-            }
-         }
+      //run cycles the way this run's policy needs
+      headPtr = kernel->runCpuBurst(headPtr, configPtr, *currentProcess,
+                        processQueue, interruptQueue, simClock, processCmd);
 
-      }
       //if this CPU operation was completed, update CPU cycles left 
       // for next CPU command
       if((*currentProcess)->cpuCyclesLeft == 0)
       { 
+         //check whole burst against its prediction, if predicting
+         if(configPtr->burstAlpha > 0)
+         {
+            recordCpuBurst(processQueue, *currentProcess,
+                           getCommandTime(currentCommand, configPtr), configPtr);
+         }
          (*currentProcess)->cpuCyclesLeft = getNextCpuCycles(*currentProcess);
       }
       if((*currentProcess)->processState == RUNNING)
       {
          //report end of command
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ", ");
-         concatenateString(endOutput, header);
-         concatenateString(endOutput, processCmd);
-         concatenateString(endOutput, " end");
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startProcessLogLine(endOutput, currentTime,
+                                                            *currentProcess);
+         endLength = appendToLine(endOutput, endLength, processCmd);
+         appendToLine(endOutput, endLength, " end");
          headPtr = addToOutputList(headPtr, endOutput, configPtr);
 
       }
@@ -561,82 +1338,27 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
    //check for i/o
    if(compareString(currentCommand->command, "dev") == STR_EQ)
    {
-      ioData *ioCommand = (ioData *)malloc(sizeof(ioData));
       //print process
-      concatenateString(startOutput, header);
+      startLength = startProcessLogLine(startOutput, currentTime, 
+                                                            *currentProcess);
 
       //print device
-      sprintf(processCmd, "%s", currentCommand->strArg1);
+      processCmdLength = appendToLine(processCmd, 0, currentCommand->strArg1);
 
       //check for input and report
       if(compareString(currentCommand->inOutArg, "in") == STR_EQ)
       {
-         concatenateString(processCmd, " input operation ");
+         appendToLine(processCmd, processCmdLength, " input operation ");
       }
       else
       {
-         concatenateString(processCmd, " output operation ");
+         appendToLine(processCmd, processCmdLength, " output operation ");
       }
      
-      //set ioData command info to device and input/output info 
-      if(preemptive == True)
-      {
-         copyString(ioCommand->command, processCmd);
-         concatenateString(startOutput, "blocked for ");
-         concatenateString(startOutput, processCmd);
-
-         headPtr = addToOutputList(headPtr, startOutput, configPtr);
-
-         //get process ID
-         ioCommand->processID = (*currentProcess)->processID;
-
-
-         //get command time
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         ioCommand->endTime = currentTime + (double)getCommandTime(currentCommand, configPtr) / 1000;
-         ioCommand->nextNode = NULL;
- 
-         ioCommand->reported = False;
-            
-         //set process to waiting
-         (*currentProcess)->processState = WAITING;
-
-         //update time remaining
-         (*currentProcess)->timeRemaining -= getCommandTime(currentCommand, configPtr);
-         manageInterrupts(SIGNAL_INTERRUPT, ioCommand, interruptHead, 
-                          &processQueueHead, &headPtr, configPtr);
-      }
-      else
-      {
-         concatenateString(startOutput, processCmd);
-         concatenateString(startOutput, " start");
-
-         headPtr = addToOutputList(headPtr, startOutput, configPtr);
-
-          //get command time
-         commandTime = getCommandTime(currentCommand, configPtr);
-         commandTimePtr = &commandTime;
-
-         //run timer
-         pthread_create(&tid, NULL, runTimer, (void *)commandTimePtr);
-         pthread_join(tid, NULL);
-
-  
-         //report end of command
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ", ");
-         concatenateString(endOutput, header);
-         concatenateString(endOutput, processCmd);
-         concatenateString(endOutput, "end");
-         headPtr = addToOutputList(headPtr, endOutput, configPtr);
-
-
-      }
-
-      
-      
-    
+      //start I/O the way this run's policy needs
+      headPtr = kernel->runIo(headPtr, configPtr, *currentProcess,
+                            currentCommand, processQueue, interruptQueue,
+                            simClock, startOutput, startLength, processCmd);
    }
 
    //check for mem
@@ -647,13 +1369,14 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
       Boolean memOpStatus;
 
       //get time and create header
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(startOutput, "%f", currentTime);
-         concatenateString(startOutput, ", ");
-         concatenateString(startOutput, header);
-         concatenateString(startOutput, "attempting mem ");
-         concatenateString(startOutput, currentCommand->strArg1);
-         concatenateString(startOutput, " request");
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         startLength = startProcessLogLine(startOutput, currentTime,
+                                                            *currentProcess);
+         startLength = appendToLine(startOutput, startLength, 
+                                                          "attempting mem ");
+         startLength = appendToLine(startOutput, startLength, 
+                                                   currentCommand->strArg1);
+         appendToLine(startOutput, startLength, " request");
          headPtr = addToOutputList(headPtr, startOutput, configPtr);
 
       //check for mem allocate
@@ -661,82 +1384,122 @@ outputNode *processLine( outputNode *headPtr, ConfigDataType *configPtr,
       {
 
          //try to allocate memory and report attempt
-         memOpStatus = allocateMemory(currentProcess, processQueueHead, currentCommand,
-                                         configPtr);
+         memOpStatus = allocateMemory(currentProcess, processQueue->memIndex,
+                              processQueue->placement, currentCommand, configPtr);
 
          //get time
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ", ");
-         concatenateString(endOutput, header);
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startProcessLogLine(endOutput, currentTime,
+                                                            *currentProcess);
 
          
 
            //if success, report mem allocated
            if(memOpStatus == True) 
            {
-              concatenateString(endOutput, "successful mem allocate request");
+              appendToLine(endOutput, endLength, "successful mem allocate request");
            }
 
            //if failure, report failure
            else
            {
-              concatenateString(endOutput, "failed mem allocate request");
+              appendToLine(endOutput, endLength, "failed mem allocate request");
            }
 
           headPtr = addToOutputList(headPtr, endOutput, configPtr);
 
        }
+
+      //check for mem free
+      else if(compareString(currentCommand->strArg1, "free") == STR_EQ)
+      {
+         //try to free memory and report attempt
+         memOpStatus = freeMemory(*currentProcess, processQueue->memIndex,
+                                  processQueue->pagedMemory,
+                                  processQueue->placement, currentCommand);
+
+         //get time
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startProcessLogLine(endOutput, currentTime,
+                                                            *currentProcess);
+
+           //if success, report mem freed
+           if(memOpStatus == True) 
+           {
+              appendToLine(endOutput, endLength, "successful mem free request");
+              headPtr = addToOutputList(headPtr, endOutput, configPtr);
+
+              //slide live blocks together once free memory is too broken up
+              if(processQueue->placement != NULL 
+                 && configPtr->compactPercent > 0
+                 && getPlacementFragmentation(processQueue->placement)
+                                          >= configPtr->compactPercent * 10)
+              {
+                 compactMemory(processQueue, &headPtr, configPtr, simClock);
+              }
+           }
+
+           //if failure, report failure
+           else
+           {
+              appendToLine(endOutput, endLength, "failed mem free request");
+              headPtr = addToOutputList(headPtr, endOutput, configPtr);
+           }
+      }
       else
       {
          //try to access memory and report attempt
          memOpStatus = accessMemory(*currentProcess, currentCommand);
 
          //get time
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ", ");
-         concatenateString(endOutput, header);
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startProcessLogLine(endOutput, currentTime,
+                                                            *currentProcess);
 
          
 
            //if success, report mem allocated
            if(memOpStatus == True) 
            {
-              concatenateString(endOutput, "successful mem access request");
+              appendToLine(endOutput, endLength, "successful mem access request");
+              headPtr = addToOutputList(headPtr, endOutput, configPtr);
+
+              //bring in pages of access, if paging
+              if(processQueue->pagedMemory != NULL)
+              {
+                 headPtr = servicePageFaults(headPtr, configPtr,
+                                   *currentProcess, processQueue,
+                                   interruptQueue, simClock, kernel);
+              }
            }
 
            //if failure, report failure
            else
            {
-              concatenateString(endOutput, "failed mem access request");
+              appendToLine(endOutput, endLength, "failed mem access request");
+              headPtr = addToOutputList(headPtr, endOutput, configPtr);
            }
-         headPtr = addToOutputList(headPtr, endOutput, configPtr);
 
       }   
       if(memOpStatus == False)
       {
          //if operation failed, report segmentation fault
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ",  OS: Process ");
-         sprintf(intBuffer, "%d", (*currentProcess)->processID);
-         concatenateString(endOutput, intBuffer);
-         concatenateString(endOutput, " experiences segmentation fault");         
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startLogLine(endOutput, currentTime);
+         endLength = appendToLine(endOutput, endLength, " OS: Process ");
+         endLength = appendIntToLine(endOutput, endLength,
+                                                (*currentProcess)->processID);
+         appendToLine(endOutput, endLength, " experiences segmentation fault");         
          headPtr = addToOutputList(headPtr, endOutput, configPtr);
         
          //set process to exiting and report
-         currentTime = accessTimer(LAP_TIMER, timeBuffer);
-         sprintf(endOutput, "%f", currentTime);
-         concatenateString(endOutput, ", ");
-
-         concatenateString(endOutput, " OS: Process ");
-         sprintf(intBuffer, "%d", (*currentProcess)->processID);
- 
-         concatenateString(endOutput, intBuffer);
-         concatenateString(endOutput, " ");
-         concatenateString(endOutput, "set from RUNNING to EXITING");
-         (*currentProcess)->processState = EXITING;
+         currentTime = accessTimer(simClock, LAP_TIMER);
+         endLength = startLogLine(endOutput, currentTime);
+         endLength = appendToLine(endOutput, endLength, " OS: Process ");
+         endLength = appendIntToLine(endOutput, endLength,
+                                                (*currentProcess)->processID);
+         appendToLine(endOutput, endLength, " set from RUNNING to EXITING");
+         setProcessState(processQueue, *currentProcess, EXITING);
 
 
   
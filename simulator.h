@@ -7,6 +7,10 @@
 #include "simtimer.h"
 #include "outputops.h"
 #include "memops.h"
+#include "heapops.h"
+#include "wheelops.h"
+#include "processops.h"
+#include "schedops.h"
 #include <pthread.h> 
 
 //types
@@ -14,19 +18,72 @@ typedef enum {CHECK_FOR_INTERRUPTS,
               SIGNAL_INTERRUPT, 
               CLEAR_ALL_INTERRUPTS} interruptCtrlCode;
 
+typedef struct InterruptQueue
+   {
+      MinHeap *pending;    //outstanding I/O, earliest end time on top
+      TimingWheel *wheel;  //outstanding I/O when run with timing wheel,
+                           // heap is unused then
+      long requestCount;   //number of I/O requests ever queued, keeps
+                           // requests ending together in request order
+   } InterruptQueue;
+
+typedef struct SimKernel
+   {
+      Boolean preemptive;  //I/O ends by interrupt, cleared after each op
+
+      //runs CPU op's cycles, from start report to before end report
+      outputNode *(*runCpuBurst)( outputNode *headPtr,
+                     ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess,
+                     ProcessQueue *processQueue,
+                     InterruptQueue *interruptQueue, SimClock *simClock,
+                     char *processCmd );
+
+      //runs or starts I/O op, given its start line so far
+      outputNode *(*runIo)( outputNode *headPtr, ConfigDataType *configPtr,
+                     ProcessControlBlock *currentProcess,
+                     OpCodeType *currentCommand,
+                     ProcessQueue *processQueue,
+                     InterruptQueue *interruptQueue, SimClock *simClock,
+                     char *startOutput, int startLength, char *processCmd );
+   } SimKernel;
+
 //function headers
-ioData *addToInterruptQueue( ioData *localPtr, ioData *newIoCmd );
-ioData *dequeue( ioData *headPtr, ioData *toRemove);
+void addToInterruptQueue( InterruptQueue *queue, ioData *newIoCmd );
+InterruptQueue *clearInterruptQueue( InterruptQueue *queue );
+InterruptQueue *createInterruptQueue( ConfigDataType *configPtr );
+ioData *dequeue( InterruptQueue *queue, ioData *toRemove );
+SimTime getEarliestInterrupt( InterruptQueue *queue );
+ioData *getFinishedInterrupt( InterruptQueue *queue, SimTime currentTime );
+Boolean interruptQueueIsEmpty( InterruptQueue *queue );
 Boolean manageInterrupts(int interruptCtrlCode, ioData *ioReturnData,  
-                           ioData **interruptHead, 
-                           ProcessControlBlock **queueHead, 
+                           InterruptQueue *interruptQueue, 
+                           ProcessQueue *processQueue, 
                            outputNode **outputHead, 
-                           ConfigDataType *configPtr);
+                           ConfigDataType *configPtr,
+                           SimClock *simClock);
+int getCycleHorizon( ProcessControlBlock *currentProcess, int cpuCyclesCompleted,
+                     int quantumCycles, InterruptQueue *interruptQueue,
+                     ConfigDataType *configPtr, SimClock *simClock );
+const SimKernel *getSimKernel( const SchedPolicy *policy );
 outputNode *processLine( outputNode *headPtr, 
                          ConfigDataType *configPtr,
                         ProcessControlBlock **currentProcess,
-                        ProcessControlBlock *processQueueHead,
-                        ioData **interruptHead );
+                        ProcessQueue *processQueue,
+                        InterruptQueue *interruptQueue,
+                        SimClock *simClock,
+                        const SimKernel *kernel );
+void reportBurstPredictions( ProcessQueue *processQueue, 
+                             outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock );
+void reportCpuShares( ProcessQueue *processQueue, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock );
+void reportPaging( PagedMemory *memory, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock );
+void reportPlacement( Placement *placement, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock );
+void reportWheelExpiries( TimingWheel *wheel, outputNode **outputHead,
+                             ConfigDataType *configPtr, SimClock *simClock );
 void * runIO(void * inputData);
 void runSim( ConfigDataType *configPtr, OpCodeType *metaDataMstrPtr );
 
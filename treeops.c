@@ -0,0 +1,579 @@
+#include "treeops.h"
+
+/*
+Function Name: nodeHeight
+Algorithm: reads height of subtree, empty subtree has none
+Precondition: given node or NULL
+Postcondition: returns height of subtree
+Exceptions: none
+Notes: local to tree operations
+*/
+static int nodeHeight( TreeNode *node )
+{
+   if(node == NULL)
+   {
+      return 0;
+   }
+   return node->height;
+}
+
+/*
+Function Name: updateNode
+Algorithm: sets height to one more than taller child, and largest value
+           to largest of node's value and its children's largest
+Precondition: given node whose children are correct
+Postcondition: node height and largest value are correct
+Exceptions: none
+Notes: local to tree operations
+*/
+static void updateNode( TreeNode *node )
+{
+   int leftHeight = nodeHeight(node->leftChild);
+   int rightHeight = nodeHeight(node->rightChild);
+
+   node->maxValue = node->value;
+   if(node->leftChild != NULL && node->leftChild->maxValue > node->maxValue)
+   {
+      node->maxValue = node->leftChild->maxValue;
+   }
+   if(node->rightChild != NULL 
+                           && node->rightChild->maxValue > node->maxValue)
+   {
+      node->maxValue = node->rightChild->maxValue;
+   }
+
+   if(leftHeight > rightHeight)
+   {
+      node->height = leftHeight + 1;
+   }
+   else
+   {
+      node->height = rightHeight + 1;
+   }
+}
+
+/*
+Function Name: rotateLeft
+Algorithm: lifts right child above node
+Precondition: given node with a right child
+Postcondition: returns new root of subtree, order is unchanged
+Exceptions: none
+Notes: local to tree operations
+*/
+static TreeNode *rotateLeft( TreeNode *node )
+{
+   TreeNode *newRoot = node->rightChild;
+
+   node->rightChild = newRoot->leftChild;
+   newRoot->leftChild = node;
+   updateNode(node);
+   updateNode(newRoot);
+
+   return newRoot;
+}
+
+/*
+Function Name: rotateRight
+Algorithm: lifts left child above node
+Precondition: given node with a left child
+Postcondition: returns new root of subtree, order is unchanged
+Exceptions: none
+Notes: local to tree operations
+*/
+static TreeNode *rotateRight( TreeNode *node )
+{
+   TreeNode *newRoot = node->leftChild;
+
+   node->leftChild = newRoot->rightChild;
+   newRoot->rightChild = node;
+   updateNode(node);
+   updateNode(newRoot);
+
+   return newRoot;
+}
+
+/*
+Function Name: rebalance
+Algorithm: rotates subtree whose children differ in height by two
+Precondition: given node whose subtrees are balanced
+Postcondition: returns root of balanced subtree
+Exceptions: none
+Notes: AVL rule, heights of children never differ by more than one,
+       so tree height stays O(log n); local to tree operations
+*/
+static TreeNode *rebalance( TreeNode *node )
+{
+   int balance;
+
+   updateNode(node);
+   balance = nodeHeight(node->leftChild) - nodeHeight(node->rightChild);
+
+   if(balance > 1)
+   {
+      if(nodeHeight(node->leftChild->leftChild)
+                              < nodeHeight(node->leftChild->rightChild))
+      {
+         node->leftChild = rotateLeft(node->leftChild);
+      }
+      return rotateRight(node);
+   }
+
+   if(balance < -1)
+   {
+      if(nodeHeight(node->rightChild->rightChild)
+                              < nodeHeight(node->rightChild->leftChild))
+      {
+         node->rightChild = rotateRight(node->rightChild);
+      }
+      return rotateLeft(node);
+   }
+
+   return node;
+}
+
+/*
+Function Name: insertNode
+Algorithm: recursively finds leaf position for new node by key, then
+           tie break, and rebalances on the way back up
+Precondition: given subtree root or NULL, and new leaf node
+Postcondition: returns root of subtree holding new node
+Exceptions: none
+Notes: equal key and tie break go right, after existing nodes;
+       local to tree operations
+*/
+static TreeNode *insertNode( TreeNode *localPtr, TreeNode *newNode )
+{
+   if(localPtr == NULL)
+   {
+      return newNode;
+   }
+
+   if(newNode->key < localPtr->key
+         || (newNode->key == localPtr->key
+                              && newNode->tieBreak < localPtr->tieBreak))
+   {
+      localPtr->leftChild = insertNode(localPtr->leftChild, newNode);
+   }
+   else
+   {
+      localPtr->rightChild = insertNode(localPtr->rightChild, newNode);
+   }
+   return rebalance(localPtr);
+}
+
+/*
+Function Name: removeMinNode
+Algorithm: recursively follows left children to leftmost node, replaces
+           it with its right child, and rebalances on the way back up
+Precondition: given non empty subtree root
+Postcondition: returns root of subtree without leftmost node,
+               removed node is returned as parameter
+Exceptions: none
+Notes: local to tree operations
+*/
+static TreeNode *removeMinNode( TreeNode *localPtr, TreeNode **minNode )
+{
+   if(localPtr->leftChild == NULL)
+   {
+      *minNode = localPtr;
+      return localPtr->rightChild;
+   }
+
+   localPtr->leftChild = removeMinNode(localPtr->leftChild, minNode);
+   return rebalance(localPtr);
+}
+
+/*
+Function Name: removeNode
+Algorithm: recursively finds node with given key and tie break; a node
+           with two children is replaced by leftmost node of its right
+           subtree; rebalances on the way back up
+Precondition: given subtree root or NULL, and ordering values
+Postcondition: returns root of subtree without that node,
+               removed node is returned as parameter, NULL if not found
+Exceptions: none
+Notes: local to tree operations
+*/
+static TreeNode *removeNode( TreeNode *localPtr, SimTime key, long tieBreak,
+                                                        TreeNode **foundNode )
+{
+   TreeNode *successor;
+
+   if(localPtr == NULL)
+   {
+      *foundNode = NULL;
+      return NULL;
+   }
+
+   if(key < localPtr->key
+         || (key == localPtr->key && tieBreak < localPtr->tieBreak))
+   {
+      localPtr->leftChild = removeNode(localPtr->leftChild, key, tieBreak,
+                                                                 foundNode);
+   }
+   else if(key > localPtr->key || tieBreak > localPtr->tieBreak)
+   {
+      localPtr->rightChild = removeNode(localPtr->rightChild, key, tieBreak,
+                                                                 foundNode);
+   }
+   else
+   {
+      *foundNode = localPtr;
+      if(localPtr->leftChild == NULL)
+      {
+         return localPtr->rightChild;
+      }
+      if(localPtr->rightChild == NULL)
+      {
+         return localPtr->leftChild;
+      }
+
+      successor = NULL;
+      localPtr->rightChild = removeMinNode(localPtr->rightChild, &successor);
+      successor->leftChild = localPtr->leftChild;
+      successor->rightChild = localPtr->rightChild;
+      localPtr = successor;
+   }
+   return rebalance(localPtr);
+}
+
+/*
+Function Name: findFirstFit
+Algorithm: recursively searches left part of subtree at or above given
+           key first, skipping any subtree whose largest value is too small
+Precondition: given subtree root or NULL, lowest key, and lowest value
+Postcondition: returns leftmost node at or above key whose value is at
+               least lowest value, or NULL if none
+Exceptions: none
+Notes: only subtrees along path to lowest key can fail after being
+       entered, so O(log n); local to tree operations
+*/
+static TreeNode *findFirstFit( TreeNode *localPtr, SimTime minKey, 
+                                                            long minValue )
+{
+   TreeNode *foundNode;
+
+   if(localPtr == NULL || localPtr->maxValue < minValue)
+   {
+      return NULL;
+   }
+
+   if(localPtr->key >= minKey)
+   {
+      foundNode = findFirstFit(localPtr->leftChild, minKey, minValue);
+      if(foundNode != NULL)
+      {
+         return foundNode;
+      }
+      if(localPtr->value >= minValue)
+      {
+         return localPtr;
+      }
+   }
+   return findFirstFit(localPtr->rightChild, minKey, minValue);
+}
+
+/*
+Function Name: clearNodes
+Algorithm: recursively releases both subtrees, then node
+Precondition: given subtree root or NULL
+Postcondition: all node memory returned to OS
+Exceptions: none
+Notes: local to tree operations
+*/
+static void clearNodes( TreeNode *localPtr )
+{
+   if(localPtr != NULL)
+   {
+      clearNodes(localPtr->leftChild);
+      clearNodes(localPtr->rightChild);
+      free(localPtr);
+   }
+}
+
+/*
+Function Name: createOrderedTree
+Algorithm: allocates empty tree
+Precondition: none
+Postcondition: returns pointer to empty tree
+Exceptions: none
+Notes: none
+*/
+OrderedTree *createOrderedTree( void )
+{
+   OrderedTree *tree = (OrderedTree *) malloc(sizeof(OrderedTree));
+
+   tree->rootPtr = NULL;
+   tree->spareNodes = NULL;
+   tree->size = 0;
+
+   return tree;
+}
+
+/*
+Function Name: clearOrderedTree
+Algorithm: releases every node in tree and spare list, then tree
+Precondition: given tree or NULL
+Postcondition: tree memory freed, returns NULL
+Exceptions: none
+Notes: items are owned by the caller and are not freed
+*/
+OrderedTree *clearOrderedTree( OrderedTree *tree )
+{
+   TreeNode *spareNode;
+
+   if(tree != NULL)
+   {
+      clearNodes(tree->rootPtr);
+      while(tree->spareNodes != NULL)
+      {
+         spareNode = tree->spareNodes;
+         tree->spareNodes = spareNode->rightChild;
+         free(spareNode);
+      }
+      free(tree);
+   }
+   return NULL;
+}
+
+/*
+Function Name: findTreeCeiling
+Algorithm: descends from root, remembering last node whose key is not
+           below given key
+Precondition: given tree and key
+Postcondition: returns item with smallest key not below given key,
+               smallest tie break among equal keys, or NULL if none
+Exceptions: none
+Notes: O(log n)
+*/
+void *findTreeCeiling( OrderedTree *tree, SimTime key )
+{
+   TreeNode *localPtr = tree->rootPtr;
+   TreeNode *ceilingNode = NULL;
+
+   while(localPtr != NULL)
+   {
+      if(localPtr->key >= key)
+      {
+         ceilingNode = localPtr;
+         localPtr = localPtr->leftChild;
+      }
+      else
+      {
+         localPtr = localPtr->rightChild;
+      }
+   }
+
+   if(ceilingNode == NULL)
+   {
+      return NULL;
+   }
+   return ceilingNode->item;
+}
+
+/*
+Function Name: findTreeFirstFit
+Algorithm: finds leftmost node at or above key with large enough value
+Precondition: given tree, lowest key, and lowest value
+Postcondition: returns item with smallest key not below lowest key whose
+               value is at least lowest value, or NULL if none
+Exceptions: none
+Notes: O(log n); with blocks keyed by address and valued by size, finds
+       first block after an address that can hold a size
+*/
+void *findTreeFirstFit( OrderedTree *tree, SimTime minKey, long minValue )
+{
+   TreeNode *foundNode = findFirstFit(tree->rootPtr, minKey, minValue);
+
+   if(foundNode == NULL)
+   {
+      return NULL;
+   }
+   return foundNode->item;
+}
+
+/*
+Function Name: findTreeFloor
+Algorithm: descends from root, remembering last node whose key is not
+           above given key
+Precondition: given tree and key
+Postcondition: returns item with largest key not above given key,
+               largest tie break among equal keys, or NULL if none
+Exceptions: none
+Notes: O(log n)
+*/
+void *findTreeFloor( OrderedTree *tree, SimTime key )
+{
+   TreeNode *localPtr = tree->rootPtr;
+   TreeNode *floorNode = NULL;
+
+   while(localPtr != NULL)
+   {
+      if(localPtr->key <= key)
+      {
+         floorNode = localPtr;
+         localPtr = localPtr->rightChild;
+      }
+      else
+      {
+         localPtr = localPtr->leftChild;
+      }
+   }
+
+   if(floorNode == NULL)
+   {
+      return NULL;
+   }
+   return floorNode->item;
+}
+
+/*
+Function Name: insertTreeItem
+Algorithm: inserts item with value of zero
+Precondition: given tree, ordering values, and item
+Postcondition: item is in tree
+Exceptions: none
+Notes: O(log n)
+*/
+void insertTreeItem( OrderedTree *tree, SimTime key, long tieBreak,
+                                                                void *item )
+{
+   insertTreeValue(tree, key, tieBreak, item, 0);
+}
+
+/*
+Function Name: insertTreeValue
+Algorithm: takes spare node or allocates one, fills it, and inserts it
+Precondition: given tree, ordering values, item, and its value
+Postcondition: item is in tree, its value counts toward largest values
+Exceptions: none
+Notes: O(log n); value cannot change in place, remove item and insert
+       it again
+*/
+void insertTreeValue( OrderedTree *tree, SimTime key, long tieBreak,
+                                                    void *item, long value )
+{
+   TreeNode *newNode = tree->spareNodes;
+
+   if(newNode != NULL)
+   {
+      tree->spareNodes = newNode->rightChild;
+   }
+   else
+   {
+      newNode = (TreeNode *) malloc(sizeof(TreeNode));
+   }
+
+   newNode->key = key;
+   newNode->tieBreak = tieBreak;
+   newNode->item = item;
+   newNode->value = value;
+   newNode->maxValue = value;
+   newNode->height = 1;
+   newNode->leftChild = NULL;
+   newNode->rightChild = NULL;
+
+   tree->rootPtr = insertNode(tree->rootPtr, newNode);
+   tree->size++;
+}
+
+/*
+Function Name: peekTreeMaxValue
+Algorithm: reads largest value kept at root
+Precondition: given tree
+Postcondition: returns largest value in tree, or zero if tree is empty
+Exceptions: none
+Notes: O(1)
+*/
+long peekTreeMaxValue( OrderedTree *tree )
+{
+   if(tree->rootPtr == NULL)
+   {
+      return 0;
+   }
+   return tree->rootPtr->maxValue;
+}
+
+/*
+Function Name: peekTreeMinKey
+Algorithm: follows left children to leftmost node
+Precondition: given non empty tree
+Postcondition: returns smallest key in tree
+Exceptions: none
+Notes: O(log n)
+*/
+SimTime peekTreeMinKey( OrderedTree *tree )
+{
+   TreeNode *localPtr = tree->rootPtr;
+
+   while(localPtr->leftChild != NULL)
+   {
+      localPtr = localPtr->leftChild;
+   }
+   return localPtr->key;
+}
+
+/*
+Function Name: popTreeMin
+Algorithm: removes leftmost node and keeps it for reuse
+Precondition: given tree
+Postcondition: returns item with smallest key, then tie break,
+               or NULL if tree is empty
+Exceptions: none
+Notes: O(log n)
+*/
+void *popTreeMin( OrderedTree *tree )
+{
+   TreeNode *minNode;
+
+   if(tree->rootPtr == NULL)
+   {
+      return NULL;
+   }
+
+   tree->rootPtr = removeMinNode(tree->rootPtr, &minNode);
+   tree->size--;
+
+   minNode->rightChild = tree->spareNodes;
+   tree->spareNodes = minNode;
+
+   return minNode->item;
+}
+
+/*
+Function Name: removeTreeItem
+Algorithm: removes node with given key and tie break, keeps it for reuse
+Precondition: given tree and ordering values of item
+Postcondition: returns item removed, or NULL if no node matches
+Exceptions: none
+Notes: O(log n)
+*/
+void *removeTreeItem( OrderedTree *tree, SimTime key, long tieBreak )
+{
+   TreeNode *foundNode;
+
+   tree->rootPtr = removeNode(tree->rootPtr, key, tieBreak, &foundNode);
+   if(foundNode == NULL)
+   {
+      return NULL;
+   }
+   tree->size--;
+
+   foundNode->rightChild = tree->spareNodes;
+   tree->spareNodes = foundNode;
+
+   return foundNode->item;
+}
+
+/*
+Function Name: treeIsEmpty
+Algorithm: checks node count
+Precondition: given tree
+Postcondition: returns true if tree holds no items
+Exceptions: none
+Notes: none
+*/
+Boolean treeIsEmpty( OrderedTree *tree )
+{
+   return tree->size == 0;
+}
@@ -0,0 +1,46 @@
+//pre-compiler directive
+#ifndef TREEOPS_H
+#define TREEOPS_H
+
+//header files
+#include "datatypes.h"
+#include <stdlib.h>
+
+//types
+typedef struct TreeNode
+   {
+      SimTime key;              //primary ordering value, smallest is leftmost
+      long tieBreak;            //secondary ordering value for equal keys
+      void *item;               //caller's data, not owned by the tree
+      long value;               //caller's value, zero unless given
+      long maxValue;            //largest value in subtree rooted here
+      int height;               //levels in subtree rooted here, leaf is one
+      struct TreeNode *leftChild;
+      struct TreeNode *rightChild;
+   } TreeNode;
+
+typedef struct OrderedTree
+   {
+      TreeNode *rootPtr;
+      TreeNode *spareNodes;     //released nodes kept for reuse, linked
+                                // through right child
+      int size;
+   } OrderedTree;
+
+//function headers
+OrderedTree *clearOrderedTree( OrderedTree *tree );
+OrderedTree *createOrderedTree( void );
+void *findTreeCeiling( OrderedTree *tree, SimTime key );
+void *findTreeFirstFit( OrderedTree *tree, SimTime minKey, long minValue );
+void *findTreeFloor( OrderedTree *tree, SimTime key );
+void insertTreeItem( OrderedTree *tree, SimTime key, long tieBreak,
+                                                               void *item );
+void insertTreeValue( OrderedTree *tree, SimTime key, long tieBreak,
+                                                   void *item, long value );
+long peekTreeMaxValue( OrderedTree *tree );
+SimTime peekTreeMinKey( OrderedTree *tree );
+void *popTreeMin( OrderedTree *tree );
+void *removeTreeItem( OrderedTree *tree, SimTime key, long tieBreak );
+Boolean treeIsEmpty( OrderedTree *tree );
+
+#endif //TREEOPS_H
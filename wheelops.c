@@ -0,0 +1,537 @@
+#include "wheelops.h"
+
+/*
+Function Name: appendToSlot
+Algorithm: links node at tail of slot list
+Precondition: given slot and unlinked node
+Postcondition: node is last in slot
+Exceptions: none
+Notes: local to wheel operations, O(1)
+*/
+static void appendToSlot( WheelSlot *slot, WheelNode *node )
+{
+   node->nextNode = NULL;
+
+   if(slot->tailPtr == NULL)
+   {
+      slot->headPtr = node;
+   }
+   else
+   {
+      slot->tailPtr->nextNode = node;
+   }
+   slot->tailPtr = node;
+   slot->itemCount++;
+}
+
+/*
+Function Name: takeSlot
+Algorithm: detaches whole list from slot
+Precondition: given slot
+Postcondition: slot is empty, returns former head of its list
+Exceptions: none
+Notes: local to wheel operations, O(1)
+*/
+static WheelNode *takeSlot( WheelSlot *slot )
+{
+   WheelNode *headPtr = slot->headPtr;
+
+   slot->headPtr = NULL;
+   slot->tailPtr = NULL;
+   slot->itemCount = 0;
+
+   return headPtr;
+}
+
+/*
+Function Name: takeLevelSlot
+Algorithm: detaches whole list from slot of given level, keeps level count
+Precondition: given wheel, level, and slot index
+Postcondition: slot is empty, returns former head of its list
+Exceptions: none
+Notes: local to wheel operations, O(1)
+*/
+static WheelNode *takeLevelSlot( TimingWheel *wheel, int level, int index )
+{
+   wheel->levelCount[ level ] -= wheel->slots[ level ][ index ].itemCount;
+
+   return takeSlot(&wheel->slots[ level ][ index ]);
+}
+
+/*
+Function Name: placeNode
+Algorithm: finds lowest level whose next level block holds both the
+           current tick and the node's tick, files node in that level's
+           slot for its tick, or in overflow if no level reaches
+Precondition: given wheel and node with tick no earlier than current tick
+Postcondition: node is filed where it will cascade down in time
+Exceptions: none
+Notes: local to wheel operations, O(1)
+*/
+static void placeNode( TimingWheel *wheel, WheelNode *node )
+{
+   int level;
+   int shift;
+
+   for(level = 0; level < WHEEL_LEVELS; level++)
+   {
+      shift = WHEEL_SLOT_BITS * (level + 1);
+
+      if((node->expireTick >> shift) == (wheel->currentTick >> shift))
+      {
+         shift = WHEEL_SLOT_BITS * level;
+         appendToSlot(&wheel->slots[ level ]
+                       [ (node->expireTick >> shift) & (WHEEL_SLOTS - 1) ],
+                                                                      node);
+         wheel->levelCount[ level ]++;
+         return;
+      }
+   }
+   appendToSlot(&wheel->overflow, node);
+}
+
+/*
+Function Name: replaceList
+Algorithm: files every node of list again from current tick
+Precondition: given wheel and detached list
+Postcondition: nodes moved to lower levels as current tick allows
+Exceptions: none
+Notes: local to wheel operations
+*/
+static void replaceList( TimingWheel *wheel, WheelNode *node )
+{
+   WheelNode *nextNode;
+
+   while(node != NULL)
+   {
+      nextNode = node->nextNode;
+      placeNode(wheel, node);
+      node = nextNode;
+   }
+}
+
+/*
+Function Name: nodeBefore
+Algorithm: orders two nodes by expire time, then by insertion
+Precondition: given two valid nodes
+Postcondition: returns true if first node expires before second
+Exceptions: none
+Notes: local to wheel operations
+*/
+static Boolean nodeBefore( WheelNode *first, WheelNode *second )
+{
+   if(first->expireTime != second->expireTime)
+   {
+      return first->expireTime < second->expireTime;
+   }
+   return first->sequence < second->sequence;
+}
+
+/*
+Function Name: expireNode
+Algorithm: links node into expired list in expire time order and counts it
+Precondition: given wheel and detached node that is due
+Postcondition: node is in expired list after every node that expires
+               before it
+Exceptions: none
+Notes: local to wheel operations; items of one tick can be filed out of
+       order, so only those walk the list, which is emptied on every clear
+*/
+static void expireNode( TimingWheel *wheel, WheelNode *node )
+{
+   WheelNode *prevNode;
+
+   if(wheel->expired.tailPtr == NULL
+            || nodeBefore(wheel->expired.tailPtr, node) == True)
+   {
+      appendToSlot(&wheel->expired, node);
+   }
+   else if(nodeBefore(node, wheel->expired.headPtr) == True)
+   {
+      node->nextNode = wheel->expired.headPtr;
+      wheel->expired.headPtr = node;
+      wheel->expired.itemCount++;
+   }
+   else
+   {
+      prevNode = wheel->expired.headPtr;
+      while(nodeBefore(prevNode->nextNode, node) == True)
+      {
+         prevNode = prevNode->nextNode;
+      }
+      node->nextNode = prevNode->nextNode;
+      prevNode->nextNode = node;
+      wheel->expired.itemCount++;
+   }
+
+   wheel->pendingCount--;
+   wheel->expiredThisTick++;
+   wheel->expiredTotal++;
+}
+
+/*
+Function Name: finishTick
+Algorithm: folds current tick's expiry count into totals, moves to given
+           tick, and cascades higher levels whose block starts there
+Precondition: given wheel and later tick, with no filled slot or block
+              start of a filled level between the two
+Postcondition: current tick is given tick
+Exceptions: none
+Notes: local to wheel operations, amortized O(1) per item
+*/
+static void finishTick( TimingWheel *wheel, long nextTick )
+{
+   int level;
+   int shift;
+
+   if(wheel->expiredThisTick > 0)
+   {
+      wheel->ticksWithExpiry++;
+      if(wheel->expiredThisTick > wheel->maxExpiredPerTick)
+      {
+         wheel->maxExpiredPerTick = wheel->expiredThisTick;
+      }
+      wheel->expiredThisTick = 0;
+   }
+   wheel->currentTick = nextTick;
+
+   //find highest level whose block starts at this tick
+   level = 0;
+   while(level + 1 < WHEEL_LEVELS
+     && (wheel->currentTick & ((1L << (WHEEL_SLOT_BITS * (level + 1))) - 1))
+                                                                        == 0)
+   {
+      level++;
+   }
+
+   //items past top level may now be in reach
+   if(level + 1 == WHEEL_LEVELS
+     && (wheel->currentTick & ((1L << (WHEEL_SLOT_BITS * WHEEL_LEVELS)) - 1))
+                                                                        == 0)
+   {
+      replaceList(wheel, takeSlot(&wheel->overflow));
+   }
+
+   //cascade from top down so items fall through every level they skip
+   while(level > 0)
+   {
+      shift = WHEEL_SLOT_BITS * level;
+      replaceList(wheel, takeLevelSlot(wheel, level,
+                      (wheel->currentTick >> shift) & (WHEEL_SLOTS - 1)));
+      level--;
+   }
+}
+
+/*
+Function Name: earliestInList
+Algorithm: scans list for smallest expire time
+Precondition: given non empty list
+Postcondition: returns smallest expire time in list
+Exceptions: none
+Notes: local to wheel operations
+*/
+static SimTime earliestInList( WheelNode *node )
+{
+   SimTime earliestTime = node->expireTime;
+
+   for(node = node->nextNode; node != NULL; node = node->nextNode)
+   {
+      if(node->expireTime < earliestTime)
+      {
+         earliestTime = node->expireTime;
+      }
+   }
+   return earliestTime;
+}
+
+/*
+Function Name: createTimingWheel
+Algorithm: allocates wheel with all slots empty
+Precondition: given time covered by one level zero slot
+Postcondition: returns pointer to empty wheel starting at time zero
+Exceptions: none
+Notes: tick length below one nanosecond is raised to one
+*/
+TimingWheel *createTimingWheel( SimTime tickLength )
+{
+   TimingWheel *wheel = (TimingWheel *) calloc(1, sizeof(TimingWheel));
+
+   if(tickLength < 1)
+   {
+      tickLength = 1;
+   }
+   wheel->tickLength = tickLength;
+
+   return wheel;
+}
+
+/*
+Function Name: clearTimingWheel
+Algorithm: frees every node in wheel, then wheel itself
+Precondition: given wheel or NULL, and function to free items or NULL
+Postcondition: wheel memory freed, returns NULL
+Exceptions: none
+Notes: items are only freed if a free function is given
+*/
+TimingWheel *clearTimingWheel( TimingWheel *wheel, void (*freeItem)(void *) )
+{
+   WheelNode *node;
+   WheelNode *nextNode;
+   int level;
+   int slot;
+
+   if(wheel == NULL)
+   {
+      return NULL;
+   }
+
+   //gather all lists into expired list
+   for(level = 0; level < WHEEL_LEVELS; level++)
+   {
+      for(slot = 0; slot < WHEEL_SLOTS; slot++)
+      {
+         node = takeSlot(&wheel->slots[ level ][ slot ]);
+         while(node != NULL)
+         {
+            nextNode = node->nextNode;
+            appendToSlot(&wheel->expired, node);
+            node = nextNode;
+         }
+      }
+   }
+   node = takeSlot(&wheel->overflow);
+   while(node != NULL)
+   {
+      nextNode = node->nextNode;
+      appendToSlot(&wheel->expired, node);
+      node = nextNode;
+   }
+
+   //release items and nodes
+   node = takeSlot(&wheel->expired);
+   while(node != NULL)
+   {
+      nextNode = node->nextNode;
+      if(freeItem != NULL)
+      {
+         freeItem(node->item);
+      }
+      free(node);
+      node = nextNode;
+   }
+   while(wheel->spareNodes != NULL)
+   {
+      nextNode = wheel->spareNodes->nextNode;
+      free(wheel->spareNodes);
+      wheel->spareNodes = nextNode;
+   }
+
+   free(wheel);
+   return NULL;
+}
+
+/*
+Function Name: addToTimingWheel
+Algorithm: files item in slot for tick its expire time falls in
+Precondition: given wheel, expire time, and item
+Postcondition: item is pending until wheel advances past expire time
+Exceptions: none
+Notes: O(1), reuses released nodes before allocating
+*/
+void addToTimingWheel( TimingWheel *wheel, SimTime expireTime, void *item )
+{
+   WheelNode *node = wheel->spareNodes;
+
+   if(node != NULL)
+   {
+      wheel->spareNodes = node->nextNode;
+   }
+   else
+   {
+      node = (WheelNode *) malloc(sizeof(WheelNode));
+   }
+
+   node->expireTime = expireTime;
+   node->expireTick = expireTime / wheel->tickLength;
+   node->item = item;
+   node->sequence = wheel->insertCount;
+   wheel->insertCount++;
+
+   //anything already past is filed in current tick
+   if(node->expireTick < wheel->currentTick)
+   {
+      node->expireTick = wheel->currentTick;
+   }
+
+   placeNode(wheel, node);
+   wheel->pendingCount++;
+}
+
+/*
+Function Name: advanceTimingWheel
+Algorithm: expires every item in each tick before the one holding current
+           time, then only due items of that tick; stretches of ticks with
+           nothing filed are skipped up to the next block start of the
+           lowest filled level
+Precondition: given wheel and current time, never earlier than last call
+Postcondition: every item due by current time is in expired list,
+               returns number of items expired by this call
+Exceptions: none
+Notes: amortized O(1) per item, at most one level zero block walked
+       tick by tick between cascades
+*/
+int advanceTimingWheel( TimingWheel *wheel, SimTime currentTime )
+{
+   long currentTick = currentTime / wheel->tickLength;
+   long expiredBefore = wheel->expiredTotal;
+   long nextTick;
+   int level;
+   int index;
+   WheelNode *node;
+   WheelNode *nextNode;
+
+   while(wheel->currentTick < currentTick)
+   {
+      //whole tick lies before current time
+      node = takeLevelSlot(wheel, 0, wheel->currentTick & (WHEEL_SLOTS - 1));
+      while(node != NULL)
+      {
+         nextNode = node->nextNode;
+         expireNode(wheel, node);
+         node = nextNode;
+      }
+
+      //skip to next tick anything is filed for
+      nextTick = wheel->currentTick + 1;
+      level = 0;
+      while(level < WHEEL_LEVELS && wheel->levelCount[ level ] == 0)
+      {
+         level++;
+         nextTick = ((wheel->currentTick >> (WHEEL_SLOT_BITS * level)) + 1)
+                                               << (WHEEL_SLOT_BITS * level);
+      }
+      if(wheel->pendingCount == 0 || nextTick > currentTick)
+      {
+         nextTick = currentTick;
+      }
+      finishTick(wheel, nextTick);
+   }
+
+   //current tick may hold items both before and after current time
+   index = wheel->currentTick & (WHEEL_SLOTS - 1);
+   node = takeLevelSlot(wheel, 0, index);
+   while(node != NULL)
+   {
+      nextNode = node->nextNode;
+      if(node->expireTime <= currentTime)
+      {
+         expireNode(wheel, node);
+      }
+      else
+      {
+         appendToSlot(&wheel->slots[ 0 ][ index ], node);
+         wheel->levelCount[ 0 ]++;
+      }
+      node = nextNode;
+   }
+
+   return (int)(wheel->expiredTotal - expiredBefore);
+}
+
+/*
+Function Name: getNextWheelExpiry
+Algorithm: returns first expired item's time if any are waiting, otherwise
+           scans forward from current tick, lowest level first, for first
+           filled slot and returns earliest time in it
+Precondition: given wheel
+Postcondition: returns earliest expire time of items in wheel,
+               or zero if wheel is empty
+Exceptions: none
+Notes: at most one pass over the slots of each level
+*/
+SimTime getNextWheelExpiry( TimingWheel *wheel )
+{
+   int level;
+   int slot;
+   int shift;
+   WheelNode *node;
+
+   if(wheel->expired.headPtr != NULL)
+   {
+      return wheel->expired.headPtr->expireTime;
+   }
+
+   for(level = 0; level < WHEEL_LEVELS; level++)
+   {
+      shift = WHEEL_SLOT_BITS * level;
+      slot = (wheel->currentTick >> shift) & (WHEEL_SLOTS - 1);
+
+      //current slot of higher levels has already cascaded down
+      if(level > 0)
+      {
+         slot++;
+      }
+
+      for( ; slot < WHEEL_SLOTS; slot++)
+      {
+         node = wheel->slots[ level ][ slot ].headPtr;
+         if(node != NULL)
+         {
+            return earliestInList(node);
+         }
+      }
+   }
+
+   if(wheel->overflow.headPtr != NULL)
+   {
+      return earliestInList(wheel->overflow.headPtr);
+   }
+   return 0;
+}
+
+/*
+Function Name: peekExpiredItem
+Algorithm: reads head of expired list
+Precondition: given wheel
+Postcondition: returns oldest expired item, or NULL if none
+Exceptions: none
+Notes: O(1)
+*/
+void *peekExpiredItem( TimingWheel *wheel )
+{
+   if(wheel->expired.headPtr == NULL)
+   {
+      return NULL;
+   }
+   return wheel->expired.headPtr->item;
+}
+
+/*
+Function Name: popExpiredItem
+Algorithm: unlinks head of expired list and keeps its node for reuse
+Precondition: given wheel
+Postcondition: returns oldest expired item, or NULL if none
+Exceptions: none
+Notes: O(1)
+*/
+void *popExpiredItem( TimingWheel *wheel )
+{
+   WheelNode *node = wheel->expired.headPtr;
+
+   if(node == NULL)
+   {
+      return NULL;
+   }
+
+   wheel->expired.headPtr = node->nextNode;
+   wheel->expired.itemCount--;
+   if(wheel->expired.headPtr == NULL)
+   {
+      wheel->expired.tailPtr = NULL;
+   }
+
+   node->nextNode = wheel->spareNodes;
+   wheel->spareNodes = node;
+
+   return node->item;
+}
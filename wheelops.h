@@ -0,0 +1,57 @@
+//pre-compiler directive
+#ifndef WHEELOPS_H
+#define WHEELOPS_H
+
+//header files
+#include "datatypes.h"
+#include <stdlib.h>
+
+//constants
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS ( 1 << WHEEL_SLOT_BITS )
+
+//types
+typedef struct WheelNode
+   {
+      SimTime expireTime;       //time item is due
+      long expireTick;          //tick expire time falls in
+      long sequence;            //insertion order, orders equal expire times
+      void *item;               //caller's data, not owned by the wheel
+      struct WheelNode *nextNode;
+   } WheelNode;
+
+typedef struct WheelSlot
+   {
+      WheelNode *headPtr;
+      WheelNode *tailPtr;
+      int itemCount;
+   } WheelSlot;
+
+typedef struct TimingWheel
+   {
+      SimTime tickLength;       //time covered by one level zero slot
+      long currentTick;         //all earlier ticks have been expired
+      long pendingCount;        //items not yet expired
+      long insertCount;         //items ever added
+      WheelSlot slots[ WHEEL_LEVELS ][ WHEEL_SLOTS ];
+      long levelCount[ WHEEL_LEVELS ];  //items filed in each level
+      WheelSlot overflow;       //items beyond reach of the top level
+      WheelSlot expired;        //items due, by expire time then insertion
+      WheelNode *spareNodes;    //released nodes kept for reuse
+      int expiredThisTick;      //items expired during current tick
+      int maxExpiredPerTick;    //most items expired by any one tick
+      long ticksWithExpiry;     //finished ticks that expired any item
+      long expiredTotal;        //items expired over life of the wheel
+   } TimingWheel;
+
+//function headers
+void addToTimingWheel( TimingWheel *wheel, SimTime expireTime, void *item );
+int advanceTimingWheel( TimingWheel *wheel, SimTime currentTime );
+TimingWheel *clearTimingWheel( TimingWheel *wheel, void (*freeItem)(void *) );
+TimingWheel *createTimingWheel( SimTime tickLength );
+SimTime getNextWheelExpiry( TimingWheel *wheel );
+void *peekExpiredItem( TimingWheel *wheel );
+void *popExpiredItem( TimingWheel *wheel );
+
+#endif //WHEELOPS_H